@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Loops where the order of loads, divisions and independent arithmetic matters.
+ * Compare runs of code compiled with and without the `scheduler` pass, e.g. with
+ * a dex2oat --run-passes list that omits it.
+ */
+public class SchedulingBenchmark {
+    private static final int N = 1024;
+
+    private final int[] ia = new int[N];
+    private final int[] ib = new int[N];
+    private final int[] ic = new int[N];
+    private final long[] la = new long[N];
+    private final float[] fa = new float[N];
+    private final float[] fb = new float[N];
+    private final double[] da = new double[N];
+
+    public static int intResult;
+    public static long longResult;
+    public static float floatResult;
+    public static double doubleResult;
+
+    public SchedulingBenchmark() {
+        for (int i = 0; i < N; ++i) {
+            ia[i] = i * 7 + 3;
+            ib[i] = (i % 13) + 1;
+            la[i] = i * 31L + 17L;
+            fa[i] = i * 0.5f + 1.0f;
+            fb[i] = (i % 7) + 1.0f;
+            da[i] = i * 0.25 + 2.0;
+        }
+    }
+
+    /** Independent integer divisions whose loads can be hoisted above the previous division. */
+    public void timeIntDivChains(int count) {
+        int[] a = ia;
+        int[] b = ib;
+        int sum = 0;
+        for (int r = 0; r < count; ++r) {
+            for (int i = 0; i < N; i += 2) {
+                sum += a[i] / b[i] + a[i + 1] / b[i + 1];
+            }
+        }
+        intResult = sum;
+    }
+
+    /** Long remainder interleaved with unrelated multiply-adds. */
+    public void timeLongRemMixed(int count) {
+        long[] a = la;
+        long acc = 0;
+        long poly = 1;
+        for (int r = 0; r < count; ++r) {
+            for (int i = 0; i < N; ++i) {
+                acc += a[i] % 1000003L;
+                poly = poly * 31 + a[i];
+            }
+        }
+        longResult = acc ^ poly;
+    }
+
+    /** Floating-point loop with a long division latency and independent adds. */
+    public void timeFloatDivAdd(int count) {
+        float[] a = fa;
+        float[] b = fb;
+        float sum1 = 0.0f;
+        float sum2 = 0.0f;
+        for (int r = 0; r < count; ++r) {
+            for (int i = 0; i < N; ++i) {
+                sum1 += a[i] / b[i];
+                sum2 += a[i] * b[i];
+            }
+        }
+        floatResult = sum1 + sum2;
+    }
+
+    /** Horner evaluation of several independent polynomials. */
+    public void timeDoublePolynomials(int count) {
+        double[] x = da;
+        double s = 0.0;
+        for (int r = 0; r < count; ++r) {
+            for (int i = 0; i < N; ++i) {
+                double v = x[i];
+                double p1 = ((1.5 * v + 2.5) * v + 3.5) * v + 4.5;
+                double p2 = ((0.5 * v - 1.5) * v + 2.0) * v - 1.0;
+                s += p1 / p2;
+            }
+        }
+        doubleResult = s;
+    }
+
+    /** Vectorizable loop, where loads, multiplies and stores of unrolled iterations interleave. */
+    public void timeIntVectorMulAdd(int count) {
+        int[] a = ia;
+        int[] b = ib;
+        int[] c = ic;
+        for (int r = 0; r < count; ++r) {
+            for (int i = 0; i < N; ++i) {
+                c[i] = a[i] * b[i] + (a[i] >> 2);
+            }
+        }
+        intResult = c[N - 1];
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class StringCompareToBenchmark {
+    public static final String string36 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";  // length = 36
+    public static final String string36Copy = new String(string36);
+    public static final String string1024 = makeString(1024, 'a');
+    public static final String string1024Copy = new String(string1024);
+    public static final String string1024Utf16 = makeString(1024, '\u0100');
+    public static final String string1024Utf16Copy = new String(string1024Utf16);
+
+    private static String makeString(int length, char base) {
+        StringBuilder sb = new StringBuilder(length);
+        for (int i = 0; i < length; ++i) {
+            sb.append((char) (base + (i % 26)));
+        }
+        return sb.toString();
+    }
+
+    public void timeCompareToShortEqual(int count) {
+        String s1 = string36;
+        String s2 = string36Copy;
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    public void timeCompareToLongLatin1Equal(int count) {
+        String s1 = string1024;
+        String s2 = string1024Copy;
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    public void timeCompareToLongUtf16Equal(int count) {
+        String s1 = string1024Utf16;
+        String s2 = string1024Utf16Copy;
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    public void timeCompareToLongLatin1DiffersInMiddle(int count) {
+        String s1 = string1024;
+        String s2 = string1024.substring(0, 512) + '_' + string1024.substring(513);
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(s1, s2);
+        }
+    }
+
+    static int $noinline$compareTo(String s1, String s2) {
+        if (doThrow) { throw new Error(); }
+        return s1.compareTo(s2);
+    }
+
+    public static boolean doThrow = false;
+}
@@ -113,6 +113,54 @@ public class StringIndexOfBenchmark {
         }
     }
 
+    public static final String string1024 = makeString(1024, 'a');
+    public static final String string1024Utf16 = makeString(1024, '\u0100');
+
+    private static String makeString(int length, char base) {
+        StringBuilder sb = new StringBuilder(length);
+        for (int i = 0; i < length; ++i) {
+            sb.append((char) (base + (i % 26)));
+        }
+        return sb.toString();
+    }
+
+    public void timeIndexOfLongLatin1NotFound(int count) {
+        final char c = '_';
+        String s = string1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongUtf16NotFound(int count) {
+        final char c = '_';
+        String s = string1024Utf16;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongUtf16Middle(int count) {
+        final char c = '_';
+        String s = string1024Utf16.substring(0, 512) + c + string1024Utf16.substring(512);
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfAfterLongLatin1(int count) {
+        final char c = 'z';
+        String s = string1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c, 700);
+        }
+    }
+
+    static int $noinline$indexOf(String s, char c, int fromIndex) {
+        if (doThrow) { throw new Error(); }
+        return s.indexOf(c, fromIndex);
+    }
+
     static int $noinline$indexOf(String s, char c) {
         if (doThrow) { throw new Error(); }
         return s.indexOf(c);
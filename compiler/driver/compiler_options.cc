@@ -43,6 +43,7 @@ CompilerOptions::CompilerOptions()
       large_method_threshold_(kDefaultLargeMethodThreshold),
       num_dex_methods_threshold_(kDefaultNumDexMethodsThreshold),
       inline_max_code_units_(kUnsetInlineMaxCodeUnits),
+      optimization_budget_(kDefaultOptimizationBudget),
       instruction_set_(kRuntimeISA == InstructionSet::kArm ? InstructionSet::kThumb2 : kRuntimeISA),
       instruction_set_features_(nullptr),
       no_inline_from_(),
@@ -123,8 +124,12 @@ bool CompilerOptions::ParseRegisterAllocationStrategy(const std::string& option,
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorLinearScan;
   } else if (option == "graph-color") {
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorGraphColor;
+  } else if (option == "linear-scan-weighted") {
+    register_allocation_strategy_ =
+        RegisterAllocator::Strategy::kRegisterAllocatorLinearScanWeighted;
   } else {
-    *error_msg = "Unrecognized register allocation strategy. Try linear-scan, or graph-color.";
+    *error_msg = "Unrecognized register allocation strategy. "
+                 "Try linear-scan, linear-scan-weighted, or graph-color.";
     return false;
   }
   return true;
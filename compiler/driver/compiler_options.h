@@ -68,6 +68,11 @@ class CompilerOptions final {
   static const bool kDefaultGenerateMiniDebugInfo = true;
   static const size_t kDefaultInlineMaxCodeUnits = 32;
   static constexpr size_t kUnsetInlineMaxCodeUnits = -1;
+  // Bound the work Optimizing spends on a single method. The work is estimated as the
+  // product of the number of blocks and the number of vregs (when building the graph)
+  // or instructions (before expensive passes). Zero disables the budget, which is the
+  // default so that compiled code does not change unless a caller opts in.
+  static const size_t kDefaultOptimizationBudget = 0;
 
   enum class CompilerType : uint8_t {
     kAotCompiler,             // AOT compiler.
@@ -142,6 +147,14 @@ class CompilerOptions final {
     return num_dex_methods_threshold_;
   }
 
+  size_t GetOptimizationBudget() const {
+    return optimization_budget_;
+  }
+
+  bool IsOverOptimizationBudget(size_t estimated_work) const {
+    return optimization_budget_ != 0u && estimated_work > optimization_budget_;
+  }
+
   size_t GetInlineMaxCodeUnits() const {
     return inline_max_code_units_;
   }
@@ -392,6 +405,7 @@ class CompilerOptions final {
   size_t large_method_threshold_;
   size_t num_dex_methods_threshold_;
   size_t inline_max_code_units_;
+  size_t optimization_budget_;
 
   InstructionSet instruction_set_;
   std::unique_ptr<const InstructionSetFeatures> instruction_set_features_;
@@ -60,6 +60,7 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   map.AssignIfExists(Base::LargeMethodMaxThreshold, &options->large_method_threshold_);
   map.AssignIfExists(Base::NumDexMethodsThreshold, &options->num_dex_methods_threshold_);
   map.AssignIfExists(Base::InlineMaxCodeUnitsThreshold, &options->inline_max_code_units_);
+  map.AssignIfExists(Base::OptimizationBudget, &options->optimization_budget_);
   map.AssignIfExists(Base::GenerateDebugInfo, &options->generate_debug_info_);
   map.AssignIfExists(Base::GenerateMiniDebugInfo, &options->generate_mini_debug_info_);
   map.AssignIfExists(Base::GenerateBuildID, &options->generate_build_id_);
@@ -82,7 +83,8 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
     options->dump_cfg_append_ = true;
   }
   if (map.Exists(Base::RegisterAllocationStrategy)) {
-    if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::DumpInitFailures), error_msg)) {
+    if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::RegisterAllocationStrategy),
+                                                  error_msg)) {
       return false;
     }
   }
@@ -148,6 +150,13 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     "A zero value will disable inlining. Honored only by Optimizing. Has priority\n"
                     "over the --compiler-filter option. Intended for development/experimental use.")
           .IntoKey(Map::InlineMaxCodeUnitsThreshold)
+      .Define("--optimization-budget=_")
+          .template WithType<unsigned int>()
+          .WithHelp("the maximum estimated work Optimizing spends on a method. Methods over\n"
+                    "the budget after building the graph are not compiled, and expensive passes\n"
+                    "are skipped once the graph is over the budget. A zero value disables the\n"
+                    "budget.")
+          .IntoKey(Map::OptimizationBudget)
 
       .Define({"--generate-debug-info", "-g", "--no-generate-debug-info"})
           .WithValues({true, true, false})
@@ -189,8 +198,8 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
           .IntoKey(Map::DumpTimings)
 
       .Define({"--dump-pass-timings"})
-          .WithHelp("Display a breakdown time spent in optimization passes for each compiled"
-                    " method.")
+          .WithHelp("Display a breakdown of time and arena memory spent in optimization passes"
+                    " for each compiled method.")
           .IntoKey(Map::DumpPassTimings)
 
       .Define({"--dump-stats"})
@@ -232,6 +241,9 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
 
       .Define("--register-allocation-strategy=_")
           .template WithType<std::string>()
+          .WithHelp("Select the register allocator: linear-scan (the default),\n"
+                    "linear-scan-weighted (avoids spills and reloads inside loops),\n"
+                    "or graph-color.")
           .IntoKey(Map::RegisterAllocationStrategy)
 
       .Define("--resolve-startup-const-strings=_")
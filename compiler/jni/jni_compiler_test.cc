@@ -367,6 +367,7 @@ class JniCompilerTest : public CommonCompilerTest {
   void ExceptionHandlingImpl();
   void NativeStackTraceElementImpl();
   void ReturnGlobalRefImpl();
+  void DecodeReferenceResultImpl();
   void LocalReferenceTableClearingTestImpl();
   void JavaLangSystemArrayCopyImpl();
   void CompareAndSwapIntImpl();
@@ -1432,6 +1433,42 @@ void JniCompilerTest::ReturnGlobalRefImpl() {
 
 JNI_TEST(ReturnGlobalRef)
 
+jobject decode_reference_result(JNIEnv* env, jobject, jint kind, jobject x, jobject) {
+  switch (kind) {
+    case 0:
+      return nullptr;
+    case 1:
+      return x;  // JNI transition reference.
+    case 2:
+      return env->NewLocalRef(x);
+    default:
+      return env->NewGlobalRef(x);
+  }
+}
+
+void JniCompilerTest::DecodeReferenceResultImpl() {
+  SetUpForTest(false, "fooIOO", "(ILjava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;",
+               CURRENT_JNI_WRAPPER(decode_reference_result));
+  // Without CheckJNI, the compiled stub decodes null, JNI transition and local references
+  // inline and only calls JniDecodeReferenceResult() for other references.
+  JNIEnvExt* env = down_cast<JNIEnvExt*>(env_);
+  bool old_check_jni = env->IsCheckJniEnabled();
+  env->SetCheckJniEnabled(false);
+
+  jobject result = env_->CallNonvirtualObjectMethod(jobj_, jklass_, jmethod_, 0, jklass_, nullptr);
+  EXPECT_TRUE(result == nullptr);
+  for (jint kind = 1; kind != 4; ++kind) {
+    result = env_->CallNonvirtualObjectMethod(jobj_, jklass_, jmethod_, kind, jklass_, nullptr);
+    EXPECT_EQ(JNILocalRefType, env_->GetObjectRefType(result)) << kind;
+    EXPECT_TRUE(env_->IsSameObject(result, jklass_)) << kind;
+    env_->DeleteLocalRef(result);
+  }
+
+  env->SetCheckJniEnabled(old_check_jni);
+}
+
+JNI_TEST_NORMAL_ONLY(DecodeReferenceResult)
+
 jint local_ref_test(JNIEnv* env, jobject thisObj, jint x) {
   // Add 10 local references
   ScopedObjectAccess soa(env);
@@ -462,25 +462,23 @@ static JniCompiledMethod ArtJniCompileMethodInternal(const CompilerOptions& comp
     __ Bind(suspend_check_resume.get());
   }
 
-  // 5.4 For methods with reference return, decode the `jobject` with `JniDecodeReferenceResult()`.
+  // 5.4 For methods with reference return, decode the `jobject`. Null, JNI transition and local
+  //     references are decoded inline, other references and CheckJNI use the slow path
+  //     calling `JniDecodeReferenceResult()`.
+  std::unique_ptr<JNIMacroLabel> decode_reference_slow_path =
+      reference_return ? __ CreateLabel() : nullptr;
+  std::unique_ptr<JNIMacroLabel> decode_reference_resume =
+      reference_return ? __ CreateLabel() : nullptr;
   if (reference_return) {
     DCHECK(!is_critical_native);
-    // We abuse the JNI calling convention here, that is guaranteed to support passing
-    // two pointer arguments, `JNIEnv*` and `jclass`/`jobject`.
-    main_jni_conv->ResetIterator(FrameOffset(main_out_arg_size));
-    ThreadOffset<kPointerSize> jni_decode_reference_result =
-        QUICK_ENTRYPOINT_OFFSET(kPointerSize, pJniDecodeReferenceResult);
-    // Pass result.
-    SetNativeParameter(jni_asm.get(), main_jni_conv.get(), mr_conv->ReturnRegister());
-    main_jni_conv->Next();
-    if (main_jni_conv->IsCurrentParamInRegister()) {
-      __ GetCurrentThread(main_jni_conv->CurrentParamRegister());
-      __ Call(main_jni_conv->CurrentParamRegister(), Offset(jni_decode_reference_result));
-    } else {
-      __ GetCurrentThread(main_jni_conv->CurrentParamStackOffset());
-      __ CallFromThread(jni_decode_reference_result);
-    }
-  }  // if (!is_critical_native)
+    __ DecodeJNITransitionOrLocalReference(mr_conv->ReturnRegister(),
+                                           jni_env_reg,
+                                           __ CoreRegisterWithSize(callee_save_temp,
+                                                                   kRawPointerSize),
+                                           decode_reference_slow_path.get(),
+                                           decode_reference_resume.get());
+    __ Bind(decode_reference_resume.get());
+  }
 
   // 6. Pop local reference frame.
   if (LIKELY(!is_critical_native)) {
@@ -614,7 +612,34 @@ static JniCompiledMethod ArtJniCompileMethodInternal(const CompilerOptions& comp
     __ Jump(suspend_check_resume.get());
   }
 
-  // 8.5. Exception poll slow path(s).
+  // 8.5. Slow path for decoding the reference result with `JniDecodeReferenceResult()`.
+  if (reference_return) {
+    __ Bind(decode_reference_slow_path.get());
+    if (main_out_arg_size != 0) {
+      jni_asm->cfi().AdjustCFAOffset(main_out_arg_size);
+    }
+    // We abuse the JNI calling convention here, that is guaranteed to support passing
+    // two pointer arguments, `JNIEnv*` and `jclass`/`jobject`.
+    main_jni_conv->ResetIterator(FrameOffset(main_out_arg_size));
+    ThreadOffset<kPointerSize> jni_decode_reference_result =
+        QUICK_ENTRYPOINT_OFFSET(kPointerSize, pJniDecodeReferenceResult);
+    // Pass result.
+    SetNativeParameter(jni_asm.get(), main_jni_conv.get(), mr_conv->ReturnRegister());
+    main_jni_conv->Next();
+    if (main_jni_conv->IsCurrentParamInRegister()) {
+      __ GetCurrentThread(main_jni_conv->CurrentParamRegister());
+      __ Call(main_jni_conv->CurrentParamRegister(), Offset(jni_decode_reference_result));
+    } else {
+      __ GetCurrentThread(main_jni_conv->CurrentParamStackOffset());
+      __ CallFromThread(jni_decode_reference_result);
+    }
+    if (main_out_arg_size != 0) {
+      jni_asm->cfi().AdjustCFAOffset(-main_out_arg_size);
+    }
+    __ Jump(decode_reference_resume.get());
+  }
+
+  // 8.6. Exception poll slow path(s).
   if (LIKELY(!is_critical_native)) {
     __ Bind(exception_slow_path.get());
     if (reference_return) {
@@ -550,7 +550,8 @@ class BCEVisitor : public HGraphVisitor {
     }
     // We should never deoptimize from an osr method, otherwise we might wrongly optimize
     // code dominated by the deoptimization.
-    if (!GetGraph()->IsCompilingOsr()) {
+    if (!GetGraph()->IsCompilingOsr() &&
+        !GetGraph()->IsDeoptimizationKindDisabled(DeoptimizationKind::kBlockBCE)) {
       AddComparesWithDeoptimization(block);
     }
   }
@@ -1673,6 +1674,12 @@ class BCEVisitor : public HGraphVisitor {
       if (GetGraph()->IsCompilingOsr()) {
         return false;
       }
+      // Don't deoptimize again if loop-based dynamic bce made previously compiled
+      // code for this method deoptimize too often.
+      if (GetGraph()->IsDeoptimizationKindDisabled(DeoptimizationKind::kLoopBoundsBCE) ||
+          GetGraph()->IsDeoptimizationKindDisabled(DeoptimizationKind::kLoopNullBCE)) {
+        return false;
+      }
       // A try boundary preheader is hard to handle.
       // TODO: remove this restriction.
       if (loop->GetPreHeader()->GetLastInstruction()->IsTryBoundary()) {
@@ -354,6 +354,68 @@ TEST_F(BoundsCheckEliminationTest, ConstantArrayBoundsElimination) {
   ASSERT_TRUE(IsRemoved(bounds_check4));
 }
 
+// array[0] = 1; // Replaced by a deoptimization, unless disabled.
+// array[1] = 1; // Replaced by a deoptimization, unless disabled.
+static void BuildDominatorBasedDeoptGraph(HGraph* graph,
+                                          ArenaAllocator* allocator,
+                                          HBoundsCheck** bounds_check0,
+                                          HBoundsCheck** bounds_check1) {
+  HBasicBlock* entry = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(entry);
+  graph->SetEntryBlock(entry);
+  HInstruction* parameter = new (allocator) HParameterValue(
+      graph->GetDexFile(), dex::TypeIndex(0), 0, DataType::Type::kReference);
+  entry->AddInstruction(parameter);
+
+  HInstruction* constant_0 = graph->GetIntConstant(0);
+  HInstruction* constant_1 = graph->GetIntConstant(1);
+
+  HBasicBlock* block = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(block);
+  entry->AddSuccessor(block);
+
+  HBoundsCheck** bounds_checks[] = { bounds_check0, bounds_check1 };
+  HInstruction* indexes[] = { constant_0, constant_1 };
+  for (size_t i = 0; i != 2u; ++i) {
+    HNullCheck* null_check = new (allocator) HNullCheck(parameter, 0);
+    HArrayLength* array_length = new (allocator) HArrayLength(null_check, 0);
+    HBoundsCheck* bounds_check = new (allocator) HBoundsCheck(indexes[i], array_length, 0);
+    HInstruction* array_set = new (allocator) HArraySet(
+        null_check, bounds_check, constant_1, DataType::Type::kInt32, 0);
+    block->AddInstruction(null_check);
+    block->AddInstruction(array_length);
+    block->AddInstruction(bounds_check);
+    block->AddInstruction(array_set);
+    *bounds_checks[i] = bounds_check;
+  }
+  block->AddInstruction(new (allocator) HGoto());
+
+  HBasicBlock* exit = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(exit);
+  block->AddSuccessor(exit);
+  exit->AddInstruction(new (allocator) HExit());
+}
+
+TEST_F(BoundsCheckEliminationTest, DominatorBasedDeoptimization) {
+  HBoundsCheck* bounds_check0 = nullptr;
+  HBoundsCheck* bounds_check1 = nullptr;
+  BuildDominatorBasedDeoptGraph(graph_, GetAllocator(), &bounds_check0, &bounds_check1);
+  RunBCE();
+  ASSERT_TRUE(IsRemoved(bounds_check0));
+  ASSERT_TRUE(IsRemoved(bounds_check1));
+}
+
+// Deoptimization feedback from previously compiled code disables the transformation.
+TEST_F(BoundsCheckEliminationTest, DominatorBasedDeoptimizationDisabled) {
+  HBoundsCheck* bounds_check0 = nullptr;
+  HBoundsCheck* bounds_check1 = nullptr;
+  BuildDominatorBasedDeoptGraph(graph_, GetAllocator(), &bounds_check0, &bounds_check1);
+  graph_->DisableDeoptimizationKind(DeoptimizationKind::kBlockBCE);
+  RunBCE();
+  ASSERT_FALSE(IsRemoved(bounds_check0));
+  ASSERT_FALSE(IsRemoved(bounds_check1));
+}
+
 // for (int i=initial; i<array.length; i+=increment) { array[i] = 10; }
 static HInstruction* BuildSSAGraph1(HGraph* graph,
                                     ArenaAllocator* allocator,
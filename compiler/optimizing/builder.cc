@@ -93,6 +93,18 @@ bool HGraphBuilder::SkipCompilation(size_t number_of_branches) {
     return true;
   }
 
+  // Building the SSA form keeps the values of all vregs for each block, so
+  // do not attempt it for methods that would take too long to compile anyway.
+  size_t estimated_work = graph_->GetBlocks().size() * code_item_accessor_.RegistersSize();
+  if (compiler_options.IsOverOptimizationBudget(estimated_work)) {
+    VLOG(compiler) << "Skip compilation of method over the optimization budget "
+                   << dex_file_->PrettyMethod(dex_compilation_unit_->GetDexMethodIndex())
+                   << ": " << graph_->GetBlocks().size() << " blocks, "
+                   << code_item_accessor_.RegistersSize() << " vregs";
+    MaybeRecordStat(compilation_stats_, MethodCompilationStat::kNotCompiledOverBudget);
+    return true;
+  }
+
   return false;
 }
 
@@ -992,6 +992,65 @@ void InstructionCodeGeneratorARM64Neon::VisitVecUShr(HVecUShr* instruction) {
   }
 }
 
+void LocationsBuilderARM64Neon::VisitVecCondition(HVecCondition* instruction) {
+  CreateVecBinOpLocations(GetGraph()->GetAllocator(), instruction);
+}
+
+void InstructionCodeGeneratorARM64Neon::VisitVecCondition(HVecCondition* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  VRegister lhs = VRegisterFrom(locations->InAt(0));
+  VRegister rhs = VRegisterFrom(locations->InAt(1));
+  VRegister dst = VRegisterFrom(locations->Out());
+  bool is_equal = instruction->GetCondition() == kCondEQ;
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      if (is_equal) {
+        __ Cmeq(dst.V4S(), lhs.V4S(), rhs.V4S());
+      } else {
+        __ Cmgt(dst.V4S(), lhs.V4S(), rhs.V4S());
+      }
+      break;
+    case DataType::Type::kInt64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      if (is_equal) {
+        __ Cmeq(dst.V2D(), lhs.V2D(), rhs.V2D());
+      } else {
+        __ Cmgt(dst.V2D(), lhs.V2D(), rhs.V2D());
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void LocationsBuilderARM64Neon::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetOut(Location::SameAsFirstInput());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorARM64Neon::VisitVecSelect(HVecSelect* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  VRegister mask = VRegisterFrom(locations->InAt(0));
+  VRegister true_value = VRegisterFrom(locations->InAt(1));
+  VRegister false_value = VRegisterFrom(locations->InAt(2));
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  // The mask is all ones or all zeros in every lane, so the lanes do not matter.
+  __ Bsl(mask.V16B(), true_value.V16B(), false_value.V16B());
+}
+
 void LocationsBuilderARM64Neon::VisitVecSetScalars(HVecSetScalars* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
 
@@ -862,6 +862,28 @@ void InstructionCodeGeneratorARM64Sve::VisitVecUShr(HVecUShr* instruction) {
   }
 }
 
+// The loop vectorizer does not generate HVecCondition and HVecSelect in predicated mode
+// (see HLoopOptimization::kNoSelect).
+void LocationsBuilderARM64Sve::VisitVecCondition(HVecCondition* instruction) {
+  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
+  UNREACHABLE();
+}
+
+void InstructionCodeGeneratorARM64Sve::VisitVecCondition(HVecCondition* instruction) {
+  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
+  UNREACHABLE();
+}
+
+void LocationsBuilderARM64Sve::VisitVecSelect(HVecSelect* instruction) {
+  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
+  UNREACHABLE();
+}
+
+void InstructionCodeGeneratorARM64Sve::VisitVecSelect(HVecSelect* instruction) {
+  LOG(FATAL) << "Unsupported SIMD instruction " << instruction->GetId();
+  UNREACHABLE();
+}
+
 void LocationsBuilderARM64Sve::VisitVecSetScalars(HVecSetScalars* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
 
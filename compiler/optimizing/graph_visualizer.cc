@@ -607,6 +607,11 @@ class HGraphVisualizerPrinter : public HGraphDelegateVisitor {
     StartAttributeStream("rounded") << std::boolalpha << hadd->IsRounded() << std::noboolalpha;
   }
 
+  void VisitVecCondition(HVecCondition* instruction) override {
+    VisitVecBinaryOperation(instruction);
+    StartAttributeStream("condition") << instruction->GetCondition();
+  }
+
   void VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instruction) override {
     VisitVecOperation(instruction);
     StartAttributeStream("kind") << instruction->GetOpKind();
@@ -364,6 +364,10 @@ ArtMethod* HInliner::FindMethodFromCHA(ArtMethod* resolved_method) {
     // We do not support HDeoptimize in OSR methods.
     return nullptr;
   }
+  if (outermost_graph_->IsDeoptimizationKindDisabled(DeoptimizationKind::kCHA)) {
+    // CHA guards made previously compiled code for this method deoptimize too often.
+    return nullptr;
+  }
   PointerSize pointer_size = caller_compilation_unit_.GetClassLinker()->GetImagePointerSize();
   ArtMethod* single_impl = resolved_method->GetSingleImplementation(pointer_size);
   if (single_impl == nullptr) {
@@ -515,21 +519,60 @@ bool HInliner::TryInlineFromCHA(HInvoke* invoke_instruction) {
   uint32_t dex_pc = invoke_instruction->GetDexPc();
   HInstruction* cursor = invoke_instruction->GetPrevious();
   HBasicBlock* bb_cursor = invoke_instruction->GetBlock();
+  ArtMethod* resolved_method = invoke_instruction->GetResolvedMethod();
   if (!TryInlineAndReplace(invoke_instruction,
                            method,
                            ReferenceTypeInfo::CreateInvalid(),
                            /* do_rtp= */ true)) {
-    return false;
+    return TryDevirtualizeFromCHA(invoke_instruction, method);
   }
   AddCHAGuard(invoke_instruction, dex_pc, cursor, bb_cursor);
   // Add dependency due to devirtualization: we are assuming the resolved method
   // has a single implementation.
-  outermost_graph_->AddCHASingleImplementationDependency(invoke_instruction->GetResolvedMethod());
+  outermost_graph_->AddCHASingleImplementationDependency(resolved_method);
   MaybeRecordStat(stats_, MethodCompilationStat::kCHAInline);
   return true;
 }
 
-bool HInliner::UseOnlyPolymorphicInliningWithNoDeopt() {
+bool HInliner::TryDevirtualizeFromCHA(HInvoke* invoke_instruction, ArtMethod* method) {
+  // Only interface calls are worth devirtualizing here: a virtual call is a
+  // single vtable load away from its target, while an interface call has to go
+  // through the IMT and possibly an ImtConflictTable lookup.
+  if (!invoke_instruction->IsInvokeInterface()) {
+    return false;
+  }
+  uint32_t dex_pc = invoke_instruction->GetDexPc();
+  HInstruction* cursor = invoke_instruction->GetPrevious();
+  HBasicBlock* bb_cursor = invoke_instruction->GetBlock();
+  ArtMethod* resolved_method = invoke_instruction->GetResolvedMethod();
+  HInvoke* replacement = nullptr;
+  if (!TryDevirtualize(invoke_instruction, method, &replacement)) {
+    return false;
+  }
+  LOG_NOTE() << "Devirtualized interface call to " << method->PrettyMethod() << " using CHA";
+  // The direct call is only valid as long as `resolved_method` keeps a single
+  // implementation, so guard it the same way as a CHA-inlined body.
+  AddCHAGuard(replacement, dex_pc, cursor, bb_cursor);
+  outermost_graph_->AddCHASingleImplementationDependency(resolved_method);
+  MaybeRecordStat(stats_, MethodCompilationStat::kCHADevirtualizedInterface);
+  return true;
+}
+
+bool HInliner::IsSpeculationDisabled(HInvoke* invoke_instruction, DeoptimizationKind kind) const {
+  if (!outermost_graph_->IsDeoptimizationKindDisabled(kind)) {
+    return false;
+  }
+  if (graph_ != outermost_graph_) {
+    // Deoptimizations are recorded against call sites of the outermost method,
+    // so we cannot tell which inlined call site failed.
+    return true;
+  }
+  ProfilingInfo* profiling_info = outermost_graph_->GetProfilingInfo();
+  DCHECK(profiling_info != nullptr);
+  return profiling_info->HasDeoptimizedAt(invoke_instruction->GetDexPc());
+}
+
+bool HInliner::UseOnlyPolymorphicInliningWithNoDeopt(HInvoke* invoke_instruction) {
   // If we are compiling AOT or OSR, pretend the call using inline caches is polymorphic and
   // do not generate a deopt.
   //
@@ -554,7 +597,13 @@ bool HInliner::UseOnlyPolymorphicInliningWithNoDeopt() {
   //
   // For OSR:
   //     We may come from the interpreter and it may have seen different receiver types.
-  return Runtime::Current()->IsAotCompiler() || outermost_graph_->IsCompilingOsr();
+  //
+  // For JIT:
+  //     If the inline cache guard at this call site made previously compiled code
+  //     deoptimize too often, the inline cache is not stable enough to deoptimize on.
+  return Runtime::Current()->IsAotCompiler() ||
+      outermost_graph_->IsCompilingOsr() ||
+      IsSpeculationDisabled(invoke_instruction, DeoptimizationKind::kJitInlineCache);
 }
 bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -588,7 +637,7 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
 
     case kInlineCacheMonomorphic: {
       MaybeRecordStat(stats_, MethodCompilationStat::kMonomorphicCall);
-      if (UseOnlyPolymorphicInliningWithNoDeopt()) {
+      if (UseOnlyPolymorphicInliningWithNoDeopt(invoke_instruction)) {
         return TryInlinePolymorphicCall(invoke_instruction, classes);
       } else {
         return TryInlineMonomorphicCall(invoke_instruction, classes);
@@ -963,7 +1012,8 @@ bool HInliner::TryInlinePolymorphicCall(
     // In monomorphic cases when UseOnlyPolymorphicInliningWithNoDeopt() is true, we call
     // `TryInlinePolymorphicCall` even though we are monomorphic.
     const bool actually_monomorphic = number_of_types == 1;
-    DCHECK_IMPLIES(actually_monomorphic, UseOnlyPolymorphicInliningWithNoDeopt());
+    DCHECK_IMPLIES(actually_monomorphic,
+                   UseOnlyPolymorphicInliningWithNoDeopt(invoke_instruction));
 
     // We only want to limit recursive polymorphic cases, not monomorphic ones.
     const bool too_many_polymorphic_recursive_calls =
@@ -993,7 +1043,7 @@ bool HInliner::TryInlinePolymorphicCall(
 
       // If we have inlined all targets before, and this receiver is the last seen,
       // we deoptimize instead of keeping the original invoke instruction.
-      bool deoptimize = !UseOnlyPolymorphicInliningWithNoDeopt() &&
+      bool deoptimize = !UseOnlyPolymorphicInliningWithNoDeopt(invoke_instruction) &&
           all_targets_inlined &&
           (i + 1 == number_of_types);
 
@@ -1197,7 +1247,8 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
   bb_cursor->InsertInstructionAfter(class_table_get, receiver_class);
   bb_cursor->InsertInstructionAfter(compare, class_table_get);
 
-  if (outermost_graph_->IsCompilingOsr()) {
+  if (outermost_graph_->IsCompilingOsr() ||
+      IsSpeculationDisabled(invoke_instruction, DeoptimizationKind::kJitSameTarget)) {
     CreateDiamondPatternForPolymorphicInline(compare, return_replacement, invoke_instruction);
   } else {
     HDeoptimize* deoptimize = new (graph_->GetAllocator()) HDeoptimize(
@@ -165,6 +165,12 @@ class HInliner : public HOptimization {
   bool TryInlineFromCHA(HInvoke* invoke_instruction)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // When CHA-based inlining of an interface call fails, try replacing the
+  // interface dispatch with a direct call to the single implementation `method`,
+  // guarded by a CHA deoptimization check.
+  bool TryDevirtualizeFromCHA(HInvoke* invoke_instruction, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
   // When we fail inlining `invoke_instruction`, we will try to devirtualize the
   // call.
   bool TryDevirtualize(HInvoke* invoke_instruction,
@@ -212,7 +218,11 @@ class HInliner : public HOptimization {
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Returns whether or not we should use only polymorphic inlining with no deoptimizations.
-  bool UseOnlyPolymorphicInliningWithNoDeopt();
+  bool UseOnlyPolymorphicInliningWithNoDeopt(HInvoke* invoke_instruction);
+
+  // Returns whether a speculation guarded by a deoptimization of `kind` at
+  // `invoke_instruction` failed too often in previously compiled code.
+  bool IsSpeculationDisabled(HInvoke* invoke_instruction, DeoptimizationKind kind) const;
 
   // Try CHA-based devirtualization to change virtual method calls into
   // direct calls.
@@ -1395,6 +1395,58 @@ static void CreateStringIndexOfLocations(HInvoke* invoke,
   locations->AddTemp(Location::RegisterLocation(RCX));
   // Need another temporary to be able to compute the result.
   locations->AddTemp(Location::RequiresRegister());
+  // The SIMD search loop needs the broadcast search value and the compared data.
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+}
+
+// Scan the string data at RDI for the char in RAX, comparing 16 bytes at a time and
+// finishing with `repne scasb` or `repne scasw` for the remaining chars. On return,
+// `counter` (RCX) holds the number of chars after the match, or the flags are set to
+// not equal if there is no match. Matches found by the SIMD loop branch to `found`
+// with the index of the match relative to RDI in TMP.
+static void GenerateStringIndexOfScan(X86_64Assembler* assembler,
+                                      CpuRegister counter,
+                                      XmmRegister search_vector,
+                                      XmmRegister data,
+                                      bool is_compressed,
+                                      Label* found,
+                                      Label* not_found) {
+  const int32_t chars_per_vector = is_compressed ? 16 : 8;
+  // Broadcast the char to all lanes. x86-64 guarantees SSE2, so no feature check is needed.
+  __ movd(search_vector, CpuRegister(RAX), /* is64bit= */ false);
+  if (is_compressed) {
+    __ punpcklbw(search_vector, search_vector);
+  }
+  __ punpcklwd(search_vector, search_vector);
+  __ pshufd(search_vector, search_vector, Immediate(0));
+
+  NearLabel loop, tail;
+  __ Bind(&loop);
+  __ cmpl(counter, Immediate(chars_per_vector));
+  __ j(kLess, &tail);
+  __ movdqu(data, Address(CpuRegister(RDI), 0));
+  if (is_compressed) {
+    __ pcmpeqb(data, search_vector);
+  } else {
+    __ pcmpeqw(data, search_vector);
+  }
+  __ pmovmskb(CpuRegister(TMP), data);
+  __ testl(CpuRegister(TMP), CpuRegister(TMP));
+  __ j(kNotZero, found);
+  __ addq(CpuRegister(RDI), Immediate(16));
+  __ subl(counter, Immediate(chars_per_vector));
+  __ jmp(&loop);
+
+  // Fewer chars than fit in a vector remain; reading past them could leave the object.
+  __ Bind(&tail);
+  __ testl(counter, counter);
+  __ j(kEqual, not_found);
+  if (is_compressed) {
+    __ repne_scasb();
+  } else {
+    __ repne_scasw();
+  }
 }
 
 static void GenerateStringIndexOf(HInvoke* invoke,
@@ -1410,6 +1462,8 @@ static void GenerateStringIndexOf(HInvoke* invoke,
   CpuRegister search_value = locations->InAt(1).AsRegister<CpuRegister>();
   CpuRegister counter = locations->GetTemp(0).AsRegister<CpuRegister>();
   CpuRegister string_length = locations->GetTemp(1).AsRegister<CpuRegister>();
+  XmmRegister search_vector = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+  XmmRegister data = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
   CpuRegister out = locations->Out().AsRegister<CpuRegister>();
 
   // Check our assumptions for registers.
@@ -1452,7 +1506,7 @@ static void GenerateStringIndexOf(HInvoke* invoke,
 
   // Do a zero-length check. Even with string compression `count == 0` means empty.
   // TODO: Support jecxz.
-  NearLabel not_found_label;
+  Label not_found_label;
   __ testl(string_length, string_length);
   __ j(kEqual, &not_found_label);
 
@@ -1498,6 +1552,11 @@ static void GenerateStringIndexOf(HInvoke* invoke,
     __ leaq(counter, Address(string_length, counter, ScaleFactor::TIMES_1, 0));
   }
 
+  // Everything is set up for the scan:
+  //   * Comparison address in RDI.
+  //   * Counter in ECX.
+  Label found_in_vector;
+  Label found_compressed_in_vector;
   if (mirror::kUseStringCompression) {
     NearLabel uncompressed_string_comparison;
     NearLabel comparison_done;
@@ -1507,16 +1566,31 @@ static void GenerateStringIndexOf(HInvoke* invoke,
     __ cmpl(search_value, Immediate(127));
     __ j(kGreater, &not_found_label);
     // Comparing byte-per-byte.
-    __ repne_scasb();
+    GenerateStringIndexOfScan(assembler,
+                              counter,
+                              search_vector,
+                              data,
+                              /* is_compressed= */ true,
+                              &found_compressed_in_vector,
+                              &not_found_label);
     __ jmp(&comparison_done);
-    // Everything is set up for repne scasw:
-    //   * Comparison address in RDI.
-    //   * Counter in ECX.
     __ Bind(&uncompressed_string_comparison);
-    __ repne_scasw();
+    GenerateStringIndexOfScan(assembler,
+                              counter,
+                              search_vector,
+                              data,
+                              /* is_compressed= */ false,
+                              &found_in_vector,
+                              &not_found_label);
     __ Bind(&comparison_done);
   } else {
-    __ repne_scasw();
+    GenerateStringIndexOfScan(assembler,
+                              counter,
+                              search_vector,
+                              data,
+                              /* is_compressed= */ false,
+                              &found_in_vector,
+                              &not_found_label);
   }
   // Did we find a match?
   __ j(kNotEqual, &not_found_label);
@@ -1528,6 +1602,22 @@ static void GenerateStringIndexOf(HInvoke* invoke,
   NearLabel done;
   __ jmp(&done);
 
+  // Matched in the SIMD loop: the index is string_length - counter plus the position of
+  // the first set bit of the comparison mask, in chars.
+  NearLabel compute_vector_index;
+  __ Bind(&found_in_vector);
+  __ bsfl(CpuRegister(TMP), CpuRegister(TMP));
+  __ shrl(CpuRegister(TMP), Immediate(1));
+  if (mirror::kUseStringCompression) {
+    __ jmp(&compute_vector_index);
+    __ Bind(&found_compressed_in_vector);
+    __ bsfl(CpuRegister(TMP), CpuRegister(TMP));
+  }
+  __ Bind(&compute_vector_index);
+  __ subl(string_length, counter);
+  __ leal(out, Address(string_length, CpuRegister(TMP), ScaleFactor::TIMES_1, 0));
+  __ jmp(&done);
+
   // Failed to match; return -1.
   __ Bind(&not_found_label);
   __ movl(out, Immediate(-1));
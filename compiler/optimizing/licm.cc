@@ -16,6 +16,9 @@
 
 #include "licm.h"
 
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "load_store_analysis.h"
 #include "side_effects_analysis.h"
 
 namespace art {
@@ -78,6 +81,155 @@ static void UpdateLoopPhisIn(HEnvironment* environment, HLoopInformation* info)
   }
 }
 
+/**
+ * Returns the heap location accessed by `instruction`, or kHeapLocationNotFound if
+ * `instruction` is not a field or array access known to `heap_locations`.
+ */
+static size_t FindHeapLocation(HInstruction* instruction,
+                               const HeapLocationCollector& heap_locations) {
+  if (instruction->IsInstanceFieldGet() ||
+      instruction->IsInstanceFieldSet() ||
+      instruction->IsStaticFieldGet() ||
+      instruction->IsStaticFieldSet()) {
+    return heap_locations.GetFieldHeapLocation(instruction->InputAt(0),
+                                               &instruction->GetFieldInfo());
+  } else if (instruction->IsArrayGet() || instruction->IsArraySet()) {
+    return heap_locations.GetArrayHeapLocation(instruction);
+  }
+  return HeapLocationCollector::kHeapLocationNotFound;
+}
+
+/**
+ * Returns whether `other` may access the heap location `location`. Accesses
+ * unknown to `heap_locations`, e.g. invokes, may access any location.
+ */
+static bool MayAccess(HInstruction* other,
+                      size_t location,
+                      const HeapLocationCollector& heap_locations) {
+  size_t other_location = FindHeapLocation(other, heap_locations);
+  return other_location == HeapLocationCollector::kHeapLocationNotFound ||
+         other_location == location ||
+         heap_locations.MayAlias(location, other_location);
+}
+
+/**
+ * Collects the instructions of the loop that read or write the heap, including
+ * those of inner loops. Returns whether any instruction of the loop can throw.
+ */
+static bool CollectHeapAccesses(HLoopInformation* loop_info,
+                                ScopedArenaVector<HInstruction*>* reads,
+                                ScopedArenaVector<HInstruction*>* writes) {
+  bool can_throw = false;
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    for (HInstructionIterator it(it_loop.Current()->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (instruction->GetSideEffects().DoesAnyRead()) {
+        reads->push_back(instruction);
+      }
+      if (instruction->GetSideEffects().DoesAnyWrite()) {
+        writes->push_back(instruction);
+      }
+      can_throw = can_throw || instruction->CanThrow();
+    }
+  }
+  return can_throw;
+}
+
+/**
+ * Returns whether `load` reads a heap location that no instruction of the loop
+ * writes. This is more precise than the loop side effects, which do not tell
+ * apart fields or arrays of the same type.
+ */
+static bool IsInvariantLoad(HInstruction* load,
+                            const ScopedArenaVector<HInstruction*>& loop_writes,
+                            const HeapLocationCollector& heap_locations) {
+  if (!load->IsInstanceFieldGet() && !load->IsArrayGet()) {
+    return false;
+  }
+  size_t location = FindHeapLocation(load, heap_locations);
+  if (location == HeapLocationCollector::kHeapLocationNotFound) {
+    return false;
+  }
+  for (HInstruction* write : loop_writes) {
+    if (load->GetSideEffects().MayDependOn(write->GetSideEffects()) &&
+        MayAccess(write, location, heap_locations)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Returns whether `store` can be moved to the single exit of the loop: it writes
+ * a loop invariant heap location that no other instruction of the loop accesses,
+ * and it is executed on every iteration before the loop is exited.
+ */
+static bool CanSinkStore(HInstruction* store,
+                         HLoopInformation* loop_info,
+                         HBasicBlock* exiting_block,
+                         const ScopedArenaVector<HInstruction*>& loop_reads,
+                         const ScopedArenaVector<HInstruction*>& loop_writes,
+                         const HeapLocationCollector& heap_locations) {
+  if (!store->IsInstanceFieldSet() && !store->IsArraySet()) {
+    return false;
+  }
+  if (!store->GetBlock()->Dominates(exiting_block)) {
+    return false;
+  }
+  // The stored value may be computed in the loop, but not the location.
+  size_t number_of_location_inputs = store->IsArraySet() ? 2u : 1u;
+  for (size_t i = 0; i != number_of_location_inputs; ++i) {
+    HLoopInformation* input_loop = store->InputAt(i)->GetBlock()->GetLoopInformation();
+    if (input_loop != nullptr && input_loop->IsIn(*loop_info)) {
+      return false;
+    }
+  }
+  size_t location = FindHeapLocation(store, heap_locations);
+  if (location == HeapLocationCollector::kHeapLocationNotFound) {
+    return false;
+  }
+  for (HInstruction* read : loop_reads) {
+    if (read->GetSideEffects().MayDependOn(store->GetSideEffects()) &&
+        MayAccess(read, location, heap_locations)) {
+      return false;
+    }
+  }
+  for (HInstruction* write : loop_writes) {
+    if (write != store && MayAccess(write, location, heap_locations)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Returns the block outside the loop that the loop exits to, if there is a single
+ * such block, only reached from the loop, and sets `exiting_block` to its predecessor.
+ * Returns null otherwise.
+ */
+static HBasicBlock* FindSingleExit(HLoopInformation* loop_info, HBasicBlock** exiting_block) {
+  HBasicBlock* exit = nullptr;
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    for (HBasicBlock* successor : block->GetSuccessors()) {
+      if (!loop_info->Contains(*successor)) {
+        if (exit != nullptr) {
+          return nullptr;
+        }
+        exit = successor;
+        *exiting_block = block;
+      }
+    }
+  }
+  if (exit == nullptr ||
+      exit->IsExitBlock() ||
+      exit->IsCatchBlock() ||
+      exit->GetPredecessors().size() != 1u) {
+    return nullptr;
+  }
+  return exit;
+}
+
 bool LICM::Run() {
   bool didLICM = false;
   DCHECK(side_effects_.HasRun());
@@ -91,6 +243,22 @@ bool LICM::Run() {
                                                           kArenaAllocLICM);
   }
 
+  // Alias information for heap accesses is only computed if side effects alone
+  // prevent hoisting a load out of a loop or sinking a store.
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  LoadStoreAnalysis lsa(graph_, /* stats= */ nullptr, &allocator, LoadStoreAnalysisType::kBasic);
+  bool lsa_has_run = false;
+  bool has_heap_locations = false;
+  auto heap_locations_available = [&]() {
+    if (!lsa_has_run) {
+      has_heap_locations = lsa.Run();
+      lsa_has_run = true;
+    }
+    return has_heap_locations;
+  };
+  ScopedArenaVector<HInstruction*> loop_reads(allocator.Adapter(kArenaAllocLICM));
+  ScopedArenaVector<HInstruction*> loop_writes(allocator.Adapter(kArenaAllocLICM));
+
   // Post order visit to visit inner loops before outer loops.
   for (HBasicBlock* block : graph_->GetPostOrder()) {
     if (!block->IsLoopHeader()) {
@@ -102,6 +270,27 @@ bool LICM::Run() {
     SideEffects loop_effects = side_effects_.GetLoopEffects(block);
     HBasicBlock* pre_header = loop_info->GetPreHeader();
 
+    loop_reads.clear();
+    loop_writes.clear();
+    bool heap_accesses_collected = false;
+    auto is_loop_invariant_read = [&](HInstruction* instruction) {
+      if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
+        return true;
+      }
+      if (!instruction->IsInstanceFieldGet() && !instruction->IsArrayGet()) {
+        return false;
+      }
+      if (loop_effects.Includes(SideEffects::AllWrites()) || !heap_locations_available()) {
+        // The loop has an invoke or similar, or there is no alias information.
+        return false;
+      }
+      if (!heap_accesses_collected) {
+        CollectHeapAccesses(loop_info, &loop_reads, &loop_writes);
+        heap_accesses_collected = true;
+      }
+      return IsInvariantLoad(instruction, loop_writes, lsa.GetHeapLocationCollector());
+    };
+
     for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
       HBasicBlock* inner = it_loop.Current();
       DCHECK(inner->IsInLoop());
@@ -140,11 +329,11 @@ bool LICM::Run() {
                 // in the loop header so far have been hoisted out, we can hoist
                 // the clinit check out also.
                 can_move = true;
-              } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
+              } else if (is_loop_invariant_read(instruction)) {
                 can_move = true;
               }
             }
-          } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
+          } else if (is_loop_invariant_read(instruction)) {
             can_move = true;
           }
         }
@@ -168,6 +357,42 @@ bool LICM::Run() {
         }
       }
     }
+
+    // Sink stores to loop invariant locations that are not otherwise accessed in the
+    // loop to the loop exit. Only the last stored value is then visible, so this is
+    // only done if nothing in the loop can throw, and the debugger cannot observe the
+    // intermediate values.
+    if (graph_->IsDebuggable() ||
+        loop_info->ContainsIrreducibleLoop() ||
+        !loop_effects.DoesAnyWrite() ||
+        loop_effects.Includes(SideEffects::AllWrites())) {
+      continue;
+    }
+    HBasicBlock* exiting_block = nullptr;
+    HBasicBlock* exit = FindSingleExit(loop_info, &exiting_block);
+    if (exit == nullptr || !heap_locations_available()) {
+      continue;
+    }
+    loop_reads.clear();
+    loop_writes.clear();
+    if (CollectHeapAccesses(loop_info, &loop_reads, &loop_writes)) {
+      continue;
+    }
+    // The sunk stores access different locations, so their order does not matter.
+    HInstruction* cursor = exit->GetFirstInstruction();
+    for (HInstruction* write : loop_writes) {
+      if (write->GetBlock()->GetLoopInformation() == loop_info &&
+          CanSinkStore(write,
+                       loop_info,
+                       exiting_block,
+                       loop_reads,
+                       loop_writes,
+                       lsa.GetHeapLocationCollector())) {
+        write->MoveBefore(cursor, /* do_checks= */ false);
+        MaybeRecordStat(stats_, MethodCompilationStat::kLoopStoreSunk);
+        didLICM = true;
+      }
+    }
   }
   return didLICM;
 }
@@ -211,4 +211,90 @@ TEST_F(LICMTest, NoArrayHoisting) {
   EXPECT_EQ(set_array->GetBlock(), loop_body_);
 }
 
+TEST_F(LICMTest, FieldHoistingWithAliasAnalysis) {
+  BuildLoop();
+
+  // Populate the loop with instructions: set/get field with same types, different offsets.
+  HInstruction* get_field = new (GetAllocator()) HInstanceFieldGet(parameter_,
+                                                                   nullptr,
+                                                                   DataType::Type::kInt32,
+                                                                   MemberOffset(10),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_body_->InsertInstructionBefore(get_field, loop_body_->GetLastInstruction());
+  HInstruction* set_field = new (GetAllocator()) HInstanceFieldSet(parameter_,
+                                                                   get_field,
+                                                                   nullptr,
+                                                                   DataType::Type::kInt32,
+                                                                   MemberOffset(20),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_body_->InsertInstructionBefore(set_field, loop_body_->GetLastInstruction());
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  PerformLICM();
+  EXPECT_EQ(get_field->GetBlock(), loop_preheader_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+}
+
+TEST_F(LICMTest, StoreSinking) {
+  BuildLoop();
+
+  // Populate the loop header with a store that is executed on every iteration
+  // and on the way out of the loop.
+  HInstruction* set_field = new (GetAllocator()) HInstanceFieldSet(parameter_,
+                                                                   int_constant_,
+                                                                   nullptr,
+                                                                   DataType::Type::kInt32,
+                                                                   MemberOffset(20),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_header_->InsertInstructionBefore(set_field, loop_header_->GetLastInstruction());
+
+  EXPECT_EQ(set_field->GetBlock(), loop_header_);
+  PerformLICM();
+  EXPECT_EQ(set_field->GetBlock(), return_);
+}
+
+TEST_F(LICMTest, NoStoreSinking) {
+  BuildLoop();
+
+  // Populate the loop with instructions: the stored field is also read in the loop.
+  HInstruction* set_field = new (GetAllocator()) HInstanceFieldSet(parameter_,
+                                                                   int_constant_,
+                                                                   nullptr,
+                                                                   DataType::Type::kInt32,
+                                                                   MemberOffset(20),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_header_->InsertInstructionBefore(set_field, loop_header_->GetLastInstruction());
+  HInstruction* get_field = new (GetAllocator()) HInstanceFieldGet(parameter_,
+                                                                   nullptr,
+                                                                   DataType::Type::kInt32,
+                                                                   MemberOffset(20),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_body_->InsertInstructionBefore(get_field, loop_body_->GetLastInstruction());
+
+  PerformLICM();
+  EXPECT_EQ(set_field->GetBlock(), loop_header_);
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+}
+
 }  // namespace art
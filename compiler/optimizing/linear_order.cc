@@ -16,6 +16,9 @@
 
 #include "linear_order.h"
 
+#include <algorithm>
+
+#include "base/bit_vector-inl.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 
@@ -36,9 +39,50 @@ static bool IsInnerLoop(HLoopInformation* outer, HLoopInformation* inner) {
       && inner->IsIn(*outer);
 }
 
+// Returns whether `block` leaves the method without returning, i.e. it throws or
+// ends with a call that always throws.
+static bool EndsWithAbruptExit(HBasicBlock* block) {
+  if (block->GetSuccessors().size() != 1u || !block->GetSingleSuccessor()->IsExitBlock()) {
+    return false;
+  }
+  HInstruction* last = block->GetLastInstruction();
+  return !last->IsReturn() && !last->IsReturnVoid();
+}
+
+// Helper method to find blocks that are statically unlikely to execute: blocks
+// that always end up throwing, and blocks whose successors are all such blocks.
+// Blocks in loops are never considered cold, as loops must stay contiguous.
+static void ComputeColdBlocks(const HGraph* graph, ArenaBitVector* is_cold) {
+  // Visit in post order so that forward successors are classified first.
+  for (HBasicBlock* block : graph->GetPostOrder()) {
+    if (block->IsEntryBlock() || block->IsExitBlock() || block->IsInLoop()) {
+      continue;
+    }
+    bool cold = EndsWithAbruptExit(block);
+    if (!cold && !block->GetSuccessors().empty()) {
+      cold = std::all_of(block->GetSuccessors().begin(),
+                         block->GetSuccessors().end(),
+                         [is_cold](HBasicBlock* successor) {
+                           return is_cold->IsBitSet(successor->GetBlockId());
+                         });
+    }
+    if (cold) {
+      is_cold->SetBit(block->GetBlockId());
+    }
+  }
+}
+
 // Helper method to update work list for linear order.
 static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
-                                      HBasicBlock* block) {
+                                      HBasicBlock* block,
+                                      bool is_cold) {
+  if (is_cold) {
+    // Cold blocks are outside of any loop and are processed last, which moves
+    // them out of the way of the hot code.
+    DCHECK(!block->IsInLoop());
+    worklist->insert(worklist->begin(), block);
+    return;
+  }
   HLoopInformation* block_loop = block->GetLoopInformation();
   auto insert_pos = worklist->rbegin();  // insert_pos.base() will be the actual position.
   for (auto end = worklist->rend(); insert_pos != end; ++insert_pos) {
@@ -87,7 +131,8 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   DCHECK_EQ(linear_order.size(), graph->GetReversePostOrder().size());
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - Blocks that always end up throwing are placed after the other blocks.
   //
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -104,6 +149,8 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
     }
     forward_predecessors[block->GetBlockId()] = number_of_forward_predecessors;
   }
+  ArenaBitVector is_cold(&allocator, graph->GetBlocks().size(), false, kArenaAllocLinearOrder);
+  ComputeColdBlocks(graph, &is_cold);
   // (2): Following a worklist approach, first start with the entry block, and
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
@@ -120,7 +167,7 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        AddToListForLinearization(&worklist, successor, is_cold.IsBitSet(block_id));
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
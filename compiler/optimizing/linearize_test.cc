@@ -23,6 +23,7 @@
 #include "dex/dex_instruction.h"
 #include "driver/compiler_options.h"
 #include "graph_visualizer.h"
+#include "linear_order.h"
 #include "nodes.h"
 #include "optimizing_unit_test.h"
 #include "pretty_printer.h"
@@ -244,4 +245,47 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST_F(LinearizeTest, ThrowingBlockLast) {
+  // Structure of this graph
+  //            entry
+  //              |
+  //            body
+  //            /   \
+  //         ret   throw
+  //            \   /
+  //            exit
+  //
+  // The throwing block would naturally be visited first; it is expected to be
+  // placed after the returning block.
+  CreateGraph();
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 {{"entry", "body"},
+                                                  {"body", "ret"},
+                                                  {"body", "throw"},
+                                                  {"ret", "exit"},
+                                                  {"throw", "exit"}}));
+  HBasicBlock* entry = blks.Get("entry");
+  HBasicBlock* body = blks.Get("body");
+  HBasicBlock* ret = blks.Get("ret");
+  HBasicBlock* throw_block = blks.Get("throw");
+  HBasicBlock* exit = blks.Get("exit");
+  HInstruction* bool_value = MakeParam(DataType::Type::kBool);
+  HInstruction* exception = MakeParam(DataType::Type::kReference);
+  entry->AddInstruction(new (GetAllocator()) HGoto());
+  body->AddInstruction(new (GetAllocator()) HIf(bool_value));
+  ret->AddInstruction(new (GetAllocator()) HReturnVoid());
+  throw_block->AddInstruction(new (GetAllocator()) HThrow(exception, /* dex_pc= */ 0u));
+  exit->AddInstruction(new (GetAllocator()) HExit());
+
+  ArenaVector<HBasicBlock*> linear_order(GetAllocator()->Adapter(kArenaAllocLinearOrder));
+  LinearizeGraph(graph_, &linear_order);
+  ASSERT_EQ(linear_order.size(), 5u);
+  EXPECT_EQ(linear_order[0], entry);
+  EXPECT_EQ(linear_order[1], body);
+  EXPECT_EQ(linear_order[2], ret);
+  EXPECT_EQ(linear_order[3], throw_block);
+  EXPECT_EQ(linear_order[4], exit);
+}
+
 }  // namespace art
@@ -52,6 +52,8 @@
  * alias analysis of those heap locations. LSE then keeps track of a list of
  * heap values corresponding to the heap locations and stores that put those
  * values in these locations.
+ *  - Before the analysis, we split field loads through Phis of non-escaping
+ *    allocations into per-field Phis so that the allocations become singletons.
  *  - In phase 1, we visit basic blocks in reverse post order and for each basic
  *    block, visit instructions sequentially, recording heap values and looking
  *    for loads and stores to eliminate without relying on loop Phis.
@@ -68,6 +70,21 @@
  *    closer to their escape points and fixup non-escaping paths with their actual
  *    values, creating PHIs when needed.
  *
+ * 0. Split loads through Phis of allocations.
+ *
+ * A Phi merging allocations makes each of them non-singleton, even when the
+ * merged objects never escape, e.g. a small temporary built in both arms of an
+ * `if` or carried around a loop as in `p = new Pair(p.first + 1, p.second)`.
+ * When every input of such Phi is an allocation that does not escape and is
+ * not used again after the merge without being reallocated first, and the Phi
+ * is used only by field loads, each load `phi.f` is replaced by a new Phi of
+ * loads `input.f` at the end of the corresponding predecessors. The old Phi is
+ * then removed and the allocations are singletons for the following phases,
+ * which eliminate the new loads and, typically, the allocations themselves.
+ *
+ * The time complexity of this step is
+ *    O(phis * (instruction_uses + blocks)) .
+ *
  * 1. Walk over blocks and their instructions.
  *
  * The initial set of heap values for a basic block is
@@ -3945,6 +3962,161 @@ void LSEVisitor::FinishFullLSE() {
   }
 }
 
+// Returns whether the loads through `phi` can read the fields of `input` at the end of
+// the corresponding predecessor instead. The `input` must not escape and no other use
+// of the same object may follow the merge, otherwise its fields could change after the
+// end of the predecessor. A use that can only be reached from the merge by executing
+// the allocation again refers to a new object and does not matter.
+static bool CanLoadThroughPhiInput(HPhi* phi, HInstruction* input) {
+  if (!input->IsNewInstance()) {
+    return false;
+  }
+  bool escapes = false;
+  LambdaEscapeVisitor visitor([&](HInstruction* escape) -> bool {
+    if (escape == phi) {
+      return true;
+    }
+    escapes = true;
+    return false;
+  });
+  VisitEscapes(input, visitor);
+  if (escapes) {
+    return false;
+  }
+
+  HBasicBlock* merge = phi->GetBlock();
+  HBasicBlock* allocation_block = input->GetBlock();
+  if (allocation_block == merge) {
+    // The merge is the header of a loop allocating the object. All other uses are
+    // dominated by the allocation that follows the Phi.
+    return true;
+  }
+  HGraph* graph = merge->GetGraph();
+  ScopedArenaAllocator allocator(graph->GetArenaStack());
+  ArenaBitVector reached(
+      &allocator, graph->GetBlocks().size(), /*expandable=*/ false, kArenaAllocLSE);
+  ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLSE));
+  reached.SetBit(merge->GetBlockId());
+  worklist.push_back(merge);
+  while (!worklist.empty()) {
+    HBasicBlock* block = worklist.back();
+    worklist.pop_back();
+    for (HBasicBlock* successor : block->GetSuccessors()) {
+      if (successor != allocation_block && !reached.IsBitSet(successor->GetBlockId())) {
+        reached.SetBit(successor->GetBlockId());
+        worklist.push_back(successor);
+      }
+    }
+  }
+  return std::none_of(input->GetUses().begin(),
+                      input->GetUses().end(),
+                      [&](const HUseListNode<HInstruction*>& use) {
+                        HInstruction* user = use.GetUser();
+                        return user != phi && reached.IsBitSet(user->GetBlock()->GetBlockId());
+                      });
+}
+
+static bool CanSplitLoadsThroughPhi(HPhi* phi) {
+  if (phi->GetType() != DataType::Type::kReference || !phi->HasNonEnvironmentUses()) {
+    return false;
+  }
+  for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (!user->IsInstanceFieldGet() || user->AsInstanceFieldGet()->IsVolatile()) {
+      return false;
+    }
+  }
+  // The Phi is removed after the split, so it must not be needed for deoptimization.
+  for (const HUseListNode<HEnvironment*>& use : phi->GetEnvUses()) {
+    if (use.GetUser()->GetHolder()->IsDeoptimize()) {
+      return false;
+    }
+  }
+  for (HInstruction* input : phi->GetInputs()) {
+    if (!CanLoadThroughPhiInput(phi, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Replace loads through Phis of non-escaping allocations with Phis of loads from the
+// allocations. See "0. Split loads through Phis of allocations" at the top of this file.
+static void SplitLoadsThroughAllocationPhis(HGraph* graph, OptimizingCompilerStats* stats) {
+  if (graph->IsCompilingOsr()) {
+    // Loop Phis may be entered with objects from the interpreter frame.
+    return;
+  }
+  ScopedArenaAllocator allocator(graph->GetArenaStack());
+  ScopedArenaVector<HPhi*> phis(allocator.Adapter(kArenaAllocLSE));
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->IsCatchBlock() ||
+        (block->IsLoopHeader() && block->GetLoopInformation()->IsIrreducible())) {
+      continue;
+    }
+    for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+      HPhi* phi = it.Current()->AsPhi();
+      if (CanSplitLoadsThroughPhi(phi)) {
+        phis.push_back(phi);
+      }
+    }
+  }
+
+  ArenaAllocator* graph_allocator = graph->GetAllocator();
+  ScopedArenaVector<HInstanceFieldGet*> loads(allocator.Adapter(kArenaAllocLSE));
+  for (HPhi* phi : phis) {
+    HBasicBlock* merge = phi->GetBlock();
+    loads.clear();
+    for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+      loads.push_back(use.GetUser()->AsInstanceFieldGet());
+    }
+    for (size_t i = 0, size = loads.size(); i != size; ++i) {
+      HInstanceFieldGet* load = loads[i];
+      if (load->GetBlock() == nullptr) {
+        continue;  // Already replaced by an earlier load of the same field.
+      }
+      const FieldInfo& info = load->GetFieldInfo();
+      HPhi* field_phi = new (graph_allocator)
+          HPhi(graph_allocator, kNoRegNumber, phi->InputCount(), load->GetType());
+      for (size_t input = 0, count = phi->InputCount(); input != count; ++input) {
+        HBasicBlock* predecessor = merge->GetPredecessors()[input];
+        HInstanceFieldGet* input_load = new (graph_allocator)
+            HInstanceFieldGet(phi->InputAt(input),
+                              info.GetField(),
+                              info.GetFieldType(),
+                              info.GetFieldOffset(),
+                              info.IsVolatile(),
+                              info.GetFieldIndex(),
+                              info.GetDeclaringClassDefIndex(),
+                              info.GetDexFile(),
+                              load->GetDexPc());
+        if (load->GetType() == DataType::Type::kReference) {
+          input_load->SetReferenceTypeInfo(load->GetReferenceTypeInfo());
+        }
+        predecessor->InsertInstructionBefore(input_load, predecessor->GetLastInstruction());
+        field_phi->SetRawInputAt(input, input_load);
+      }
+      merge->AddPhi(field_phi);
+      if (load->GetType() == DataType::Type::kReference) {
+        field_phi->SetReferenceTypeInfo(load->GetReferenceTypeInfo());
+      }
+      for (size_t j = i; j != size; ++j) {
+        HInstanceFieldGet* other = loads[j];
+        if (other->GetBlock() != nullptr &&
+            other->GetFieldOffset().Uint32Value() == info.GetFieldOffset().Uint32Value() &&
+            other->GetType() == load->GetType()) {
+          other->ReplaceWith(field_phi);
+          other->GetBlock()->RemoveInstruction(other);
+        }
+      }
+    }
+    DCHECK(!phi->HasNonEnvironmentUses());
+    phi->RemoveEnvironmentUsers();
+    merge->RemovePhi(phi);
+    MaybeRecordStat(stats, MethodCompilationStat::kLoadThroughPhiSplit);
+  }
+}
+
 // The LSEVisitor is a ValueObject (indirectly through base classes) and therefore
 // cannot be directly allocated with an arena allocator, so we need to wrap it.
 class LSEVisitorWrapper : public DeletableArenaObject<kArenaAllocLSE> {
@@ -3975,6 +4147,7 @@ bool LoadStoreElimination::Run(bool enable_partial_lse) {
   // This is O(blocks^3) time complexity. It means we can query reachability in
   // O(1) though.
   graph_->ComputeReachabilityInformation();
+  SplitLoadsThroughAllocationPhis(graph_, stats_);
   ScopedArenaAllocator allocator(graph_->GetArenaStack());
   LoadStoreAnalysis lsa(graph_,
                         stats_,
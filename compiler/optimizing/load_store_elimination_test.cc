@@ -8815,6 +8815,258 @@ TEST_P(UsesOrderDependentTestGroupForThreeItems, RecordPredicatedReplacements3)
   EXPECT_INS_RETAINED(breturn_return);
 }
 
+// // ENTRY
+// if (parameter_value) {
+//   // LEFT
+//   obj = new Obj();
+//   obj.field = 1;
+// } else {
+//   // RIGHT
+//   obj = new Obj();
+//   obj.field = 2;
+// }
+// // BRETURN
+// return obj.field;
+TEST_F(LoadStoreEliminationTest, LoadThroughAllocationPhi) {
+  CreateGraph();
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 {{"entry", "left"},
+                                                  {"entry", "right"},
+                                                  {"left", "breturn"},
+                                                  {"right", "breturn"},
+                                                  {"breturn", "exit"}}));
+#define GET_BLOCK(name) HBasicBlock* name = blks.Get(#name)
+  GET_BLOCK(entry);
+  GET_BLOCK(left);
+  GET_BLOCK(right);
+  GET_BLOCK(breturn);
+  GET_BLOCK(exit);
+#undef GET_BLOCK
+  EnsurePredecessorOrder(breturn, {left, right});
+  HInstruction* bool_value = MakeParam(DataType::Type::kBool);
+  HInstruction* c1 = graph_->GetIntConstant(1);
+  HInstruction* c2 = graph_->GetIntConstant(2);
+
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* if_inst = new (GetAllocator()) HIf(bool_value);
+  entry->AddInstruction(cls);
+  entry->AddInstruction(if_inst);
+  ManuallyBuildEnvFor(cls, {});
+
+  HInstruction* new_left = MakeNewInstance(cls);
+  HInstruction* write_left = MakeIFieldSet(new_left, c1, MemberOffset(32));
+  left->AddInstruction(new_left);
+  left->AddInstruction(write_left);
+  left->AddInstruction(new (GetAllocator()) HGoto());
+  new_left->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HInstruction* new_right = MakeNewInstance(cls);
+  HInstruction* write_right = MakeIFieldSet(new_right, c2, MemberOffset(32));
+  right->AddInstruction(new_right);
+  right->AddInstruction(write_right);
+  right->AddInstruction(new (GetAllocator()) HGoto());
+  new_right->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HPhi* obj_phi = MakePhi({new_left, new_right});
+  HInstruction* read_bottom = MakeIFieldGet(obj_phi, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* return_exit = new (GetAllocator()) HReturn(read_bottom);
+  breturn->AddPhi(obj_phi);
+  breturn->AddInstruction(read_bottom);
+  breturn->AddInstruction(return_exit);
+
+  SetupExit(exit);
+
+  // PerformLSE expects this to be empty.
+  graph_->ClearDominanceInformation();
+  PerformLSENoPartial();
+
+  EXPECT_INS_REMOVED(read_bottom);
+  EXPECT_INS_REMOVED(obj_phi);
+  EXPECT_INS_REMOVED(new_left);
+  EXPECT_INS_REMOVED(new_right);
+  EXPECT_INS_REMOVED(write_left);
+  EXPECT_INS_REMOVED(write_right);
+  HPhi* value_phi = FindSingleInstruction<HPhi>(graph_, breturn);
+  ASSERT_NE(value_phi, nullptr);
+  EXPECT_INS_EQ(value_phi->InputAt(0), c1);
+  EXPECT_INS_EQ(value_phi->InputAt(1), c2);
+  EXPECT_INS_EQ(return_exit->InputAt(0), value_phi);
+}
+
+// // ENTRY
+// obj = new Obj();
+// obj.field = 1;
+// while (test()) {
+//   // LOOP_BODY
+//   next = new Obj();
+//   next.field = obj.field + 2;
+//   obj = next;
+// }
+// // BRETURN
+// return obj.field;
+TEST_F(LoadStoreEliminationTest, LoadThroughLoopAllocationPhi) {
+  CreateGraph();
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 {{"entry", "loop_pre_header"},
+                                                  {"loop_pre_header", "loop_header"},
+                                                  {"loop_header", "loop_body"},
+                                                  {"loop_header", "breturn"},
+                                                  {"loop_body", "loop_header"},
+                                                  {"breturn", "exit"}}));
+#define GET_BLOCK(name) HBasicBlock* name = blks.Get(#name)
+  GET_BLOCK(entry);
+  GET_BLOCK(loop_pre_header);
+  GET_BLOCK(loop_header);
+  GET_BLOCK(loop_body);
+  GET_BLOCK(breturn);
+  GET_BLOCK(exit);
+#undef GET_BLOCK
+  EnsurePredecessorOrder(loop_header, {loop_pre_header, loop_body});
+  HInstruction* c1 = graph_->GetIntConstant(1);
+  HInstruction* c2 = graph_->GetIntConstant(2);
+
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* new_entry = MakeNewInstance(cls);
+  HInstruction* write_entry = MakeIFieldSet(new_entry, c1, MemberOffset(32));
+  entry->AddInstruction(cls);
+  entry->AddInstruction(new_entry);
+  entry->AddInstruction(write_entry);
+  entry->AddInstruction(new (GetAllocator()) HGoto());
+  ManuallyBuildEnvFor(cls, {});
+  new_entry->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  loop_pre_header->AddInstruction(new (GetAllocator()) HGoto());
+
+  HInstruction* suspend_check_header = new (GetAllocator()) HSuspendCheck();
+  HInstruction* call_header = MakeInvoke(DataType::Type::kBool, {});
+  HInstruction* if_header = new (GetAllocator()) HIf(call_header);
+  loop_header->AddInstruction(suspend_check_header);
+  loop_header->AddInstruction(call_header);
+  loop_header->AddInstruction(if_header);
+  suspend_check_header->CopyEnvironmentFrom(cls->GetEnvironment());
+  call_header->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HInstruction* new_body = MakeNewInstance(cls);
+  loop_body->AddInstruction(new_body);
+  new_body->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HPhi* obj_phi = MakePhi({new_entry, new_body});
+  loop_header->AddPhi(obj_phi);
+
+  HInstruction* read_body = MakeIFieldGet(obj_phi, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* add_body = new (GetAllocator()) HAdd(DataType::Type::kInt32, read_body, c2);
+  HInstruction* write_body = MakeIFieldSet(new_body, add_body, MemberOffset(32));
+  loop_body->AddInstruction(read_body);
+  loop_body->AddInstruction(add_body);
+  loop_body->AddInstruction(write_body);
+  loop_body->AddInstruction(new (GetAllocator()) HGoto());
+
+  HInstruction* read_bottom = MakeIFieldGet(obj_phi, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* return_exit = new (GetAllocator()) HReturn(read_bottom);
+  breturn->AddInstruction(read_bottom);
+  breturn->AddInstruction(return_exit);
+
+  SetupExit(exit);
+
+  // PerformLSE expects this to be empty.
+  graph_->ClearDominanceInformation();
+  PerformLSENoPartial();
+
+  EXPECT_INS_REMOVED(read_body);
+  EXPECT_INS_REMOVED(read_bottom);
+  EXPECT_INS_REMOVED(obj_phi);
+  EXPECT_INS_REMOVED(new_entry);
+  EXPECT_INS_REMOVED(new_body);
+  EXPECT_INS_REMOVED(write_entry);
+  EXPECT_INS_REMOVED(write_body);
+  HPhi* value_phi = FindSingleInstruction<HPhi>(graph_, loop_header);
+  ASSERT_NE(value_phi, nullptr);
+  EXPECT_INS_EQ(value_phi->InputAt(0), c1);
+  EXPECT_INS_EQ(value_phi->InputAt(1), add_body);
+  EXPECT_INS_EQ(add_body->InputAt(0), value_phi);
+  EXPECT_INS_EQ(return_exit->InputAt(0), value_phi);
+}
+
+// // ENTRY
+// if (parameter_value) {
+//   // LEFT
+//   obj = new Obj();
+//   obj.field = 1;
+//   call_func(obj);
+// } else {
+//   // RIGHT
+//   obj = new Obj();
+//   obj.field = 2;
+// }
+// // BRETURN
+// // DO NOT ELIMINATE, the object from LEFT may have been modified.
+// return obj.field;
+TEST_F(LoadStoreEliminationTest, LoadThroughEscapingAllocationPhi) {
+  CreateGraph();
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 {{"entry", "left"},
+                                                  {"entry", "right"},
+                                                  {"left", "breturn"},
+                                                  {"right", "breturn"},
+                                                  {"breturn", "exit"}}));
+#define GET_BLOCK(name) HBasicBlock* name = blks.Get(#name)
+  GET_BLOCK(entry);
+  GET_BLOCK(left);
+  GET_BLOCK(right);
+  GET_BLOCK(breturn);
+  GET_BLOCK(exit);
+#undef GET_BLOCK
+  EnsurePredecessorOrder(breturn, {left, right});
+  HInstruction* bool_value = MakeParam(DataType::Type::kBool);
+  HInstruction* c1 = graph_->GetIntConstant(1);
+  HInstruction* c2 = graph_->GetIntConstant(2);
+
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* if_inst = new (GetAllocator()) HIf(bool_value);
+  entry->AddInstruction(cls);
+  entry->AddInstruction(if_inst);
+  ManuallyBuildEnvFor(cls, {});
+
+  HInstruction* new_left = MakeNewInstance(cls);
+  HInstruction* write_left = MakeIFieldSet(new_left, c1, MemberOffset(32));
+  HInstruction* call_left = MakeInvoke(DataType::Type::kVoid, { new_left });
+  left->AddInstruction(new_left);
+  left->AddInstruction(write_left);
+  left->AddInstruction(call_left);
+  left->AddInstruction(new (GetAllocator()) HGoto());
+  new_left->CopyEnvironmentFrom(cls->GetEnvironment());
+  call_left->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HInstruction* new_right = MakeNewInstance(cls);
+  HInstruction* write_right = MakeIFieldSet(new_right, c2, MemberOffset(32));
+  right->AddInstruction(new_right);
+  right->AddInstruction(write_right);
+  right->AddInstruction(new (GetAllocator()) HGoto());
+  new_right->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HPhi* obj_phi = MakePhi({new_left, new_right});
+  HInstruction* read_bottom = MakeIFieldGet(obj_phi, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* return_exit = new (GetAllocator()) HReturn(read_bottom);
+  breturn->AddPhi(obj_phi);
+  breturn->AddInstruction(read_bottom);
+  breturn->AddInstruction(return_exit);
+
+  SetupExit(exit);
+
+  // PerformLSE expects this to be empty.
+  graph_->ClearDominanceInformation();
+  PerformLSENoPartial();
+
+  EXPECT_INS_RETAINED(read_bottom);
+  EXPECT_INS_RETAINED(obj_phi);
+  EXPECT_INS_RETAINED(new_left);
+  EXPECT_INS_RETAINED(new_right);
+  EXPECT_INS_EQ(read_bottom->InputAt(0), obj_phi);
+}
+
 INSTANTIATE_TEST_SUITE_P(LoadStoreEliminationTest,
                          UsesOrderDependentTestGroupForThreeItems,
                          testing::Values(0u, 1u, 2u, 3u, 4u, 5u));
@@ -16,8 +16,10 @@
 
 #include "loop_analysis.h"
 
+#include "arch/x86_64/instruction_set_features_x86_64.h"
 #include "base/bit_vector-inl.h"
 #include "code_generator.h"
+#include "driver/compiler_options.h"
 #include "induction_var_range.h"
 
 namespace art {
@@ -306,9 +308,15 @@ class X86_64LoopHelper : public ArchDefaultLoopHelper {
   // avoid excessive loop unrolling to ensure LSD (loop stream decoder) is operating efficiently.
   // This variable takes care that unrolled loop instructions should not exceed LSD size.
   // For Intel Atom processors (silvermont & goldmont), LSD size is 28
-  // TODO - identify architecture and LSD size at runtime
   static constexpr uint32_t kX86_64UnrolledMaxBodySizeInstr = 28;
 
+  // Cores with AVX2 (Haswell and later, Zen) have a loop buffer or micro-op cache for at
+  // least 56 micro-ops and two or more 128-bit vector ALUs. The vectorizer only uses 128-bit
+  // vectors, so unroll deeper to keep these units busy, approaching the throughput of
+  // 256-bit vectors.
+  static constexpr uint32_t kX86_64AVX2MaxUnrollFactor = 3;  // pow(2,3) = 8
+  static constexpr uint32_t kX86_64AVX2UnrolledMaxBodySizeInstr = 56;
+
   // Loop's maximum basic block count. Loops with higher count will not be partial
   // unrolled (unknown iterations).
   static constexpr uint32_t kX86_64UnknownIterMaxBodySizeBlocks = 2;
@@ -316,7 +324,10 @@ class X86_64LoopHelper : public ArchDefaultLoopHelper {
   uint32_t GetUnrollingFactor(HLoopInformation* loop_info, HBasicBlock* header) const;
 
  public:
-  explicit X86_64LoopHelper(const CodeGenerator& codegen) : ArchDefaultLoopHelper(codegen) {}
+  explicit X86_64LoopHelper(const CodeGenerator& codegen)
+      : ArchDefaultLoopHelper(codegen),
+        has_avx2_(codegen.GetCompilerOptions().GetInstructionSetFeatures()
+                      ->AsX86_64InstructionSetFeatures()->HasAVX2()) {}
 
   uint32_t GetSIMDUnrollingFactor(HBasicBlock* block,
                                   int64_t trip_count,
@@ -357,6 +368,9 @@ class X86_64LoopHelper : public ArchDefaultLoopHelper {
 
     return unroll_factor;
   }
+
+ private:
+  const bool has_avx2_;
 };
 
 uint32_t X86_64LoopHelper::GetUnrollingFactor(HLoopInformation* loop_info,
@@ -389,8 +403,9 @@ uint32_t X86_64LoopHelper::GetUnrollingFactor(HLoopInformation* loop_info,
   }
 
   // Calculate actual unroll factor.
-  uint32_t unrolling_factor = kX86_64MaxUnrollFactor;
-  uint32_t unrolling_inst = kX86_64UnrolledMaxBodySizeInstr;
+  uint32_t unrolling_factor = has_avx2_ ? kX86_64AVX2MaxUnrollFactor : kX86_64MaxUnrollFactor;
+  uint32_t unrolling_inst =
+      has_avx2_ ? kX86_64AVX2UnrolledMaxBodySizeInstr : kX86_64UnrolledMaxBodySizeInstr;
   // "-3" for one Goto instruction.
   uint32_t desired_size = unrolling_inst - num_inst_header - 3;
   if (desired_size < (2 * num_inst_loop_body)) {
@@ -32,6 +32,10 @@ namespace art {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Maximum number of a != b runtime tests guarding a vector loop. Every test is
+// cheap, but adds to the overhead of loops that end up running sequentially.
+static constexpr size_t kMaxNumberOfRuntimeTests = 4;
+
 //
 // Static helpers.
 //
@@ -478,8 +482,7 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       vector_refs_(nullptr),
       vector_static_peeling_factor_(0),
       vector_dynamic_peeling_candidate_(nullptr),
-      vector_runtime_test_a_(nullptr),
-      vector_runtime_test_b_(nullptr),
+      vector_runtime_tests_(nullptr),
       vector_map_(nullptr),
       vector_permanent_map_(nullptr),
       vector_mode_(kSequential),
@@ -543,6 +546,8 @@ bool HLoopOptimization::LocalRun() {
   ScopedArenaSafeMap<HInstruction*, HInstruction*> reds(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSet<ArrayReference> refs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<std::pair<HInstruction*, HInstruction*>> tests(
+      loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> map(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> perm(
@@ -551,6 +556,7 @@ bool HLoopOptimization::LocalRun() {
   iset_ = &iset;
   reductions_ = &reds;
   vector_refs_ = &refs;
+  vector_runtime_tests_ = &tests;
   vector_map_ = &map;
   vector_permanent_map_ = &perm;
   // Traverse.
@@ -559,6 +565,7 @@ bool HLoopOptimization::LocalRun() {
   iset_ = nullptr;
   reductions_ = nullptr;
   vector_refs_ = nullptr;
+  vector_runtime_tests_ = nullptr;
   vector_map_ = nullptr;
   vector_permanent_map_ = nullptr;
   return did_loop_opt;
@@ -967,8 +974,7 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
   vector_refs_->clear();
   vector_static_peeling_factor_ = 0;
   vector_dynamic_peeling_candidate_ = nullptr;
-  vector_runtime_test_a_ =
-  vector_runtime_test_b_ = nullptr;
+  vector_runtime_tests_->clear();
 
   // Phis in the loop-body prevent vectorization.
   if (!block->GetPhis().IsEmpty()) {
@@ -1027,16 +1033,8 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
           // Found a[i+x] vs. b[i+y]. Accept if x == y (at worst loop-independent data dependence).
           // Conservatively assume a potential loop-carried data dependence otherwise, avoided by
           // generating an explicit a != b disambiguation runtime test on the two references.
-          if (x != y) {
-            // To avoid excessive overhead, we only accept one a != b test.
-            if (vector_runtime_test_a_ == nullptr) {
-              // First test found.
-              vector_runtime_test_a_ = a;
-              vector_runtime_test_b_ = b;
-            } else if ((vector_runtime_test_a_ != a || vector_runtime_test_b_ != b) &&
-                       (vector_runtime_test_a_ != b || vector_runtime_test_b_ != a)) {
-              return false;  // second test would be needed
-            }
+          if (x != y && !AddRuntimeTest(a, b)) {
+            return false;  // too many tests would be needed
           }
         }
       }
@@ -1080,6 +1078,20 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
   return true;
 }
 
+bool HLoopOptimization::AddRuntimeTest(HInstruction* a, HInstruction* b) {
+  DCHECK_NE(a, b);
+  for (const std::pair<HInstruction*, HInstruction*>& test : *vector_runtime_tests_) {
+    if ((test.first == a && test.second == b) || (test.first == b && test.second == a)) {
+      return true;  // already tested
+    }
+  }
+  if (vector_runtime_tests_->size() == kMaxNumberOfRuntimeTests) {
+    return false;
+  }
+  vector_runtime_tests_->push_back(std::make_pair(a, b));
+  return true;
+}
+
 void HLoopOptimization::Vectorize(LoopNode* node,
                                   HBasicBlock* block,
                                   HBasicBlock* exit,
@@ -1170,12 +1182,13 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   }
   vector_index_ = graph_->GetConstant(induc_type, 0);
 
-  // Generate runtime disambiguation test:
+  // Generate runtime disambiguation tests, which version the loop into the vector
+  // loop and the sequential cleanup loop that then executes all iterations:
   // vtc = a != b ? vtc : 0;
-  if (vector_runtime_test_a_ != nullptr) {
+  for (const std::pair<HInstruction*, HInstruction*>& test : *vector_runtime_tests_) {
     HInstruction* rt = Insert(
         preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
+        new (global_allocator_) HNotEqual(test.first, test.second));
     vtc = Insert(preheader,
                  new (global_allocator_)
                  HSelect(rt, vtc, graph_->GetConstant(induc_type, 0), kNoDexPc));
@@ -1218,7 +1231,7 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   // for ( ; i < stc; i += 1)
   //    <loop-body>
   if (needs_cleanup) {
-    DCHECK_IMPLIES(IsInPredicatedVectorizationMode(), vector_runtime_test_a_ != nullptr);
+    DCHECK_IMPLIES(IsInPredicatedVectorizationMode(), !vector_runtime_tests_->empty());
     vector_mode_ = kSequential;
     GenerateNewLoop(node,
                     block,
@@ -1616,6 +1629,82 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
       }
       return true;
     }
+  } else if (instruction->IsMin() || instruction->IsMax()) {
+    // Deal with vector restrictions.
+    HInstruction* opa = instruction->InputAt(0);
+    HInstruction* opb = instruction->InputAt(1);
+    HInstruction* r = opa;
+    HInstruction* s = opb;
+    bool is_unsigned = false;
+    if (HasVectorRestrictions(restrictions, kNoMinMax) || !DataType::IsIntegralType(type)) {
+      // The SIMD instructions do not follow the Java semantics of NaN and -0.0.
+      return false;
+    } else if (HasVectorRestrictions(restrictions, kNoHiBits) &&
+               !IsNarrowerOperands(opa, opb, type, &r, &s, &is_unsigned)) {
+      return false;  // reject, unless all operands are same-extension narrower
+    }
+    // Accept MIN/MAX(x, y) for vectorizable operands.
+    DCHECK(r != nullptr && s != nullptr);
+    if (generate_code && vector_mode_ != kVector) {  // de-idiom
+      r = opa;
+      s = opb;
+    }
+    if (VectorizeUse(node, r, generate_code, type, restrictions) &&
+        VectorizeUse(node, s, generate_code, type, restrictions)) {
+      if (generate_code) {
+        GenerateVecOp(instruction,
+                      vector_map_->Get(r),
+                      vector_map_->Get(s),
+                      HVecOperation::ToProperType(type, is_unsigned));
+      }
+      return true;
+    }
+  } else if (instruction->IsSelect()) {
+    // Deal with vector restrictions.
+    HSelect* select = instruction->AsSelect();
+    HInstruction* condition = select->GetCondition();
+    if (HasVectorRestrictions(restrictions, kNoSelect) ||
+        !condition->IsCondition() ||
+        node->loop_info->IsDefinedOutOfTheLoop(condition)) {
+      return false;
+    }
+    // Accept a select on a signed comparison of operands of the vector type (which
+    // makes the lanes of the mask match the lanes of the selected values) for
+    // vectorizable operands and values. This covers the bodies of loops with control
+    // flow that the select generator has if-converted.
+    HInstruction* opa = condition->InputAt(0);
+    HInstruction* opb = condition->InputAt(1);
+    switch (condition->AsCondition()->GetCondition()) {
+      case kCondEQ:
+      case kCondNE:
+      case kCondLT:
+      case kCondLE:
+      case kCondGT:
+      case kCondGE:
+        break;
+      default:
+        return false;
+    }
+    if (HVecOperation::ToSignedType(opa->GetType()) != HVecOperation::ToSignedType(type) ||
+        HVecOperation::ToSignedType(opb->GetType()) != HVecOperation::ToSignedType(type)) {
+      return false;
+    }
+    HInstruction* true_value = select->GetTrueValue();
+    HInstruction* false_value = select->GetFalseValue();
+    if (VectorizeUse(node, opa, generate_code, type, restrictions) &&
+        VectorizeUse(node, opb, generate_code, type, restrictions) &&
+        VectorizeUse(node, true_value, generate_code, type, restrictions) &&
+        VectorizeUse(node, false_value, generate_code, type, restrictions)) {
+      if (generate_code) {
+        GenerateVecSelect(select,
+                          vector_map_->Get(opa),
+                          vector_map_->Get(opb),
+                          vector_map_->Get(true_value),
+                          vector_map_->Get(false_value),
+                          type);
+      }
+      return true;
+    }
   }
   return false;
 }
@@ -1630,19 +1719,20 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
     case InstructionSet::kArm:
     case InstructionSet::kThumb2:
       // Allow vectorization for all ARM devices, because Android assumes that
-      // ARM 32-bit always supports advanced SIMD (64-bit SIMD).
+      // ARM 32-bit always supports advanced SIMD (64-bit SIMD). There is no code
+      // generation for vector conditions and selects (kNoSelect).
       switch (type) {
         case DataType::Type::kBool:
         case DataType::Type::kUint8:
         case DataType::Type::kInt8:
-          *restrictions |= kNoDiv | kNoReduction | kNoDotProd;
+          *restrictions |= kNoDiv | kNoReduction | kNoDotProd | kNoSelect;
           return TrySetVectorLength(type, 8);
         case DataType::Type::kUint16:
         case DataType::Type::kInt16:
-          *restrictions |= kNoDiv | kNoStringCharAt | kNoReduction | kNoDotProd;
+          *restrictions |= kNoDiv | kNoStringCharAt | kNoReduction | kNoDotProd | kNoSelect;
           return TrySetVectorLength(type, 4);
         case DataType::Type::kInt32:
-          *restrictions |= kNoDiv | kNoWideSAD;
+          *restrictions |= kNoDiv | kNoWideSAD | kNoSelect;
           return TrySetVectorLength(type, 2);
         default:
           break;
@@ -1650,7 +1740,8 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
       return false;
     case InstructionSet::kArm64:
       if (IsInPredicatedVectorizationMode()) {
-        // SVE vectorization.
+        // SVE vectorization. There is no code generation for vector conditions and
+        // selects, which would need masks in predicate registers (kNoSelect).
         CHECK(features->AsArm64InstructionSetFeatures()->HasSVE());
         size_t vector_length = simd_register_size_ / DataType::Size(type);
         DCHECK_EQ(simd_register_size_ % DataType::Size(type), 0u);
@@ -1662,7 +1753,9 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoSignedHAdd |
                              kNoUnsignedHAdd |
                              kNoUnroundedHAdd |
-                             kNoSAD;
+                             kNoSAD |
+                             kNoMinMax |
+                             kNoSelect;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kUint16:
           case DataType::Type::kInt16:
@@ -1671,19 +1764,21 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnsignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD |
-                             kNoDotProd;
+                             kNoDotProd |
+                             kNoMinMax |
+                             kNoSelect;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt32:
-            *restrictions |= kNoDiv | kNoSAD;
+            *restrictions |= kNoDiv | kNoSAD | kNoMinMax | kNoSelect;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt64:
-            *restrictions |= kNoDiv | kNoSAD;
+            *restrictions |= kNoDiv | kNoSAD | kNoMinMax | kNoSelect;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoMinMax | kNoSelect;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoMinMax | kNoSelect;
             return TrySetVectorLength(type, vector_length);
           default:
             break;
@@ -1696,23 +1791,23 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
           case DataType::Type::kBool:
           case DataType::Type::kUint8:
           case DataType::Type::kInt8:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoSelect;
             return TrySetVectorLength(type, 16);
           case DataType::Type::kUint16:
           case DataType::Type::kInt16:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoSelect;
             return TrySetVectorLength(type, 8);
           case DataType::Type::kInt32:
             *restrictions |= kNoDiv;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kInt64:
-            *restrictions |= kNoDiv | kNoMul;
+            *restrictions |= kNoDiv | kNoMul | kNoMinMax;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoSelect;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoSelect;
             return TrySetVectorLength(type, 2);
           default:
             break;
@@ -1734,7 +1829,8 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD |
-                             kNoDotProd;
+                             kNoDotProd |
+                             kNoSelect;
             return TrySetVectorLength(type, 16);
           case DataType::Type::kUint16:
             *restrictions |= kNoDiv |
@@ -1742,26 +1838,28 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD |
-                             kNoDotProd;
+                             kNoDotProd |
+                             kNoSelect;
             return TrySetVectorLength(type, 8);
           case DataType::Type::kInt16:
             *restrictions |= kNoDiv |
                              kNoAbs |
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
-                             kNoSAD;
+                             kNoSAD |
+                             kNoSelect;
             return TrySetVectorLength(type, 8);
           case DataType::Type::kInt32:
             *restrictions |= kNoDiv | kNoSAD;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kInt64:
-            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
+            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD | kNoMinMax | kNoSelect;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoSelect;
             return TrySetVectorLength(type, 4);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            *restrictions |= kNoReduction | kNoSelect;
             return TrySetVectorLength(type, 2);
           default:
             break;
@@ -2085,6 +2183,14 @@ void HLoopOptimization::GenerateVecOp(HInstruction* org,
       GENERATE_VEC(
         new (global_allocator_) HVecAbs(global_allocator_, opa, type, vector_length_, dex_pc),
         new (global_allocator_) HAbs(org_type, opa, dex_pc));
+    case HInstruction::kMin:
+      GENERATE_VEC(
+        new (global_allocator_) HVecMin(global_allocator_, opa, opb, type, vector_length_, dex_pc),
+        new (global_allocator_) HMin(org_type, opa, opb, dex_pc));
+    case HInstruction::kMax:
+      GENERATE_VEC(
+        new (global_allocator_) HVecMax(global_allocator_, opa, opb, type, vector_length_, dex_pc),
+        new (global_allocator_) HMax(org_type, opa, opb, dex_pc));
     default:
       break;
   }  // switch
@@ -2092,6 +2198,62 @@ void HLoopOptimization::GenerateVecOp(HInstruction* org,
   vector_map_->Put(org, vector);
 }
 
+void HLoopOptimization::GenerateVecSelect(HSelect* org,
+                                          HInstruction* opa,
+                                          HInstruction* opb,
+                                          HInstruction* true_value,
+                                          HInstruction* false_value,
+                                          DataType::Type type) {
+  HCondition* condition = org->GetCondition()->AsCondition();
+  uint32_t dex_pc = org->GetDexPc();
+  IfCondition cond = condition->GetCondition();
+  if (vector_map_->find(condition) == vector_map_->end()) {
+    HInstruction* mask = nullptr;
+    if (vector_mode_ == kVector) {
+      // Only equality and greater-than masks are generated; the other conditions
+      // swap the operands of the comparison and/or the selected values.
+      bool swap_operands = (cond == kCondLT || cond == kCondGE);
+      IfCondition mask_cond = (cond == kCondEQ || cond == kCondNE) ? kCondEQ : kCondGT;
+      mask = new (global_allocator_) HVecCondition(global_allocator_,
+                                                   swap_operands ? opb : opa,
+                                                   swap_operands ? opa : opb,
+                                                   mask_cond,
+                                                   type,
+                                                   vector_length_,
+                                                   condition->GetDexPc());
+    } else {
+      DCHECK(vector_mode_ == kSequential);
+      switch (cond) {
+        case kCondEQ: mask = new (global_allocator_) HEqual(opa, opb); break;
+        case kCondNE: mask = new (global_allocator_) HNotEqual(opa, opb); break;
+        case kCondLT: mask = new (global_allocator_) HLessThan(opa, opb); break;
+        case kCondLE: mask = new (global_allocator_) HLessThanOrEqual(opa, opb); break;
+        case kCondGT: mask = new (global_allocator_) HGreaterThan(opa, opb); break;
+        case kCondGE: mask = new (global_allocator_) HGreaterThanOrEqual(opa, opb); break;
+        default:
+          LOG(FATAL) << "Unexpected condition " << cond;
+          UNREACHABLE();
+      }
+    }
+    vector_map_->Put(condition, mask);
+  }
+  HInstruction* mask = vector_map_->Get(condition);
+  HInstruction* vector = nullptr;
+  if (vector_mode_ == kVector) {
+    bool swap_values = (cond == kCondNE || cond == kCondLE || cond == kCondGE);
+    vector = new (global_allocator_) HVecSelect(global_allocator_,
+                                                mask,
+                                                swap_values ? false_value : true_value,
+                                                swap_values ? true_value : false_value,
+                                                type,
+                                                vector_length_,
+                                                dex_pc);
+  } else {
+    vector = new (global_allocator_) HSelect(mask, true_value, false_value, dex_pc);
+  }
+  vector_map_->Put(org, vector);
+}
+
 #undef GENERATE_VEC
 
 //
@@ -95,6 +95,8 @@ class HLoopOptimization : public HOptimization {
     kNoSAD           = 1 << 11,  // no sum of absolute differences (SAD)
     kNoWideSAD       = 1 << 12,  // no sum of absolute differences (SAD) with operand widening
     kNoDotProd       = 1 << 13,  // no dot product
+    kNoMinMax        = 1 << 14,  // no min/max
+    kNoSelect        = 1 << 15,  // no select on a condition (if-conversion)
   };
 
   /*
@@ -187,6 +189,9 @@ class HLoopOptimization : public HOptimization {
   //
 
   bool ShouldVectorize(LoopNode* node, HBasicBlock* block, int64_t trip_count);
+  // Records that the vector loop must only execute if a != b at runtime.
+  // Returns false if this would exceed the number of tests allowed.
+  bool AddRuntimeTest(HInstruction* a, HInstruction* b);
   void Vectorize(LoopNode* node, HBasicBlock* block, HBasicBlock* exit, int64_t trip_count);
   void GenerateNewLoop(LoopNode* node,
                        HBasicBlock* block,
@@ -226,6 +231,12 @@ class HLoopOptimization : public HOptimization {
                      HInstruction* opa,
                      HInstruction* opb,
                      DataType::Type type);
+  void GenerateVecSelect(HSelect* org,
+                         HInstruction* opa,
+                         HInstruction* opb,
+                         HInstruction* true_value,
+                         HInstruction* false_value,
+                         DataType::Type type);
 
   // Vectorization idioms.
   bool VectorizeSaturationIdiom(LoopNode* node,
@@ -338,9 +349,10 @@ class HLoopOptimization : public HOptimization {
   uint32_t vector_static_peeling_factor_;
   const ArrayReference* vector_dynamic_peeling_candidate_;
 
-  // Dynamic data dependence test of the form a != b.
-  HInstruction* vector_runtime_test_a_;
-  HInstruction* vector_runtime_test_b_;
+  // Dynamic data dependence tests of the form a != b, one for each pair of
+  // references that may only be disambiguated at runtime.
+  // Contents reside in phase-local heap memory.
+  ScopedArenaVector<std::pair<HInstruction*, HInstruction*>>* vector_runtime_tests_;
 
   // Mapping used during vectorization synthesis for both the scalar peeling/cleanup
   // loop (mode is kSequential) and the actual vector loop (mode is kVector). The data
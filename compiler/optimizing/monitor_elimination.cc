@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor_elimination.h"
+
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "escape.h"
+#include "optimizing_compiler_stats.h"
+
+namespace art {
+
+// Maximum number of instructions visited between a monitor exit and the monitor enter
+// it is coarsened with. This bounds both the compile time and the length of the code
+// that will now be executed while holding the lock.
+static constexpr size_t kMaxCoarseningDistance = 32;
+
+bool MonitorElimination::TryElideMonitors(HInstruction* object) {
+  // A lock that is elided is not held when the interpreter resumes the frame after a
+  // deoptimization, and the interpreter would then fail to release it.
+  if (graph_->IsDebuggable() || graph_->IsCompilingOsr() || graph_->HasShouldDeoptimizeFlag()) {
+    return false;
+  }
+  bool is_singleton;
+  bool is_singleton_and_not_returned;
+  bool is_singleton_and_not_deopt_visible;
+  CalculateEscape(object,
+                  /* no_escape_fn= */ nullptr,
+                  &is_singleton,
+                  &is_singleton_and_not_returned,
+                  &is_singleton_and_not_deopt_visible);
+  if (!is_singleton_and_not_returned || !is_singleton_and_not_deopt_visible) {
+    return false;
+  }
+
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  ScopedArenaVector<HMonitorOperation*> monitors(allocator.Adapter(kArenaAllocMisc));
+  for (const HUseListNode<HInstruction*>& use : object->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (user->IsInvoke()) {
+      // Escape analysis does not consider invokes that do not write to the heap as
+      // escapes, but the callee may still rely on the lock being held, e.g. for
+      // Thread.holdsLock() or Object.notify().
+      return false;
+    }
+    if (user->IsMonitorOperation()) {
+      monitors.push_back(user->AsMonitorOperation());
+    }
+  }
+
+  for (HMonitorOperation* monitor : monitors) {
+    monitor->GetBlock()->RemoveInstruction(monitor);
+    MaybeRecordStat(stats_, MethodCompilationStat::kMonitorOperationElided);
+  }
+  return true;
+}
+
+bool MonitorElimination::TryCoarsenMonitors(HMonitorOperation* monitor_exit) {
+  DCHECK(!monitor_exit->IsEnter());
+  HInstruction* object = monitor_exit->InputAt(0);
+  HInstruction* current = monitor_exit->GetNext();
+  for (size_t distance = 0; distance != kMaxCoarseningDistance; ++distance) {
+    if (current->IsMonitorOperation()) {
+      if (!current->AsMonitorOperation()->IsEnter() || current->InputAt(0) != object) {
+        return false;
+      }
+      HMonitorOperation* monitor_enter = current->AsMonitorOperation();
+      monitor_exit->GetBlock()->RemoveInstruction(monitor_exit);
+      monitor_enter->GetBlock()->RemoveInstruction(monitor_enter);
+      MaybeRecordStat(stats_, MethodCompilationStat::kMonitorOperationCoarsened);
+      return true;
+    }
+    if (current->IsGoto() || current->IsTryBoundary()) {
+      // Follow the normal flow if the monitor enter can only be reached from the
+      // monitor exit.
+      HBasicBlock* successor = current->IsGoto()
+          ? current->GetBlock()->GetSingleSuccessor()
+          : current->AsTryBoundary()->GetNormalFlowSuccessor();
+      if (successor->GetPredecessors().size() != 1u ||
+          successor->IsLoopHeader() ||
+          successor->IsCatchBlock() ||
+          successor->IsExitBlock()) {
+        return false;
+      }
+      current = successor->GetFirstInstruction();
+      continue;
+    }
+    // Do not extend the locked region over instructions that may throw, block, call
+    // into the runtime or suspend.
+    if (current->IsControlFlow() || current->CanThrow() || current->NeedsEnvironment()) {
+      return false;
+    }
+    current = current->GetNext();
+  }
+  return false;
+}
+
+bool MonitorElimination::Run() {
+  if (!graph_->HasMonitorOperations()) {
+    return false;
+  }
+
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  ScopedArenaVector<HMonitorOperation*> monitors(allocator.Adapter(kArenaAllocMisc));
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      if (it.Current()->IsMonitorOperation()) {
+        monitors.push_back(it.Current()->AsMonitorOperation());
+      }
+    }
+  }
+
+  bool did_optimize = false;
+  for (HMonitorOperation* monitor : monitors) {
+    HInstruction* object = monitor->InputAt(0);
+    if (monitor->IsInBlock() &&
+        (object->IsNewInstance() || object->IsNewArray()) &&
+        TryElideMonitors(object)) {
+      did_optimize = true;
+    }
+  }
+
+  // Visit the remaining monitor exits in reverse post order, so that a chain of
+  // synchronized regions on the same object gets coarsened into a single region.
+  for (HMonitorOperation* monitor : monitors) {
+    if (monitor->IsInBlock() && !monitor->IsEnter() && TryCoarsenMonitors(monitor)) {
+      did_optimize = true;
+    }
+  }
+  return did_optimize;
+}
+
+}  // namespace art
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_MONITOR_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_MONITOR_ELIMINATION_H_
+
+#include "optimization.h"
+
+namespace art {
+
+/*
+ * Monitor Elimination.
+ *
+ * Removes monitor operations that are not needed for correctness:
+ *
+ * - Lock elision: monitor operations on an object allocated in the method
+ *   that is not visible to any other thread (a singleton according to escape
+ *   analysis) cannot be contended, so all of them are removed. This typically
+ *   happens after inlining synchronized methods or constructors of
+ *   thread-safe classes, e.g. StringBuffer.
+ *
+ * - Lock coarsening: a monitor exit followed by a monitor enter on the same
+ *   object, with only non-throwing instructions that do not need an
+ *   environment in between, merges the two synchronized regions into one.
+ *   This typically happens after inlining consecutive calls to synchronized
+ *   methods on the same receiver.
+ *
+ * Eliding a lock changes what the interpreter would see when resuming the
+ * frame, so elision is disabled when the compiled code may be deoptimized
+ * with the object live.
+ */
+class MonitorElimination : public HOptimization {
+ public:
+  MonitorElimination(HGraph* graph,
+                     OptimizingCompilerStats* stats,
+                     const char* name = kMonitorEliminationPassName)
+      : HOptimization(graph, name, stats) {}
+
+  bool Run() override;
+
+  static constexpr const char* kMonitorEliminationPassName = "monitor_elimination";
+
+ private:
+  // Remove all monitor operations on `object` if it is not visible to other threads.
+  // Return whether the monitor operations were removed.
+  bool TryElideMonitors(HInstruction* object);
+
+  // Remove `monitor_exit` and a monitor enter on the same object that closely follows it.
+  // Return whether the monitor operations were removed.
+  bool TryCoarsenMonitors(HMonitorOperation* monitor_exit);
+
+  DISALLOW_COPY_AND_ASSIGN(MonitorElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_MONITOR_ELIMINATION_H_
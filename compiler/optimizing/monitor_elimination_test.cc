@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor_elimination.h"
+
+#include "base/arena_allocator.h"
+#include "nodes.h"
+#include "optimizing_unit_test.h"
+
+namespace art {
+
+class MonitorEliminationTest : public OptimizingUnitTest {
+ protected:
+  // Create a graph with a single block `main` between the entry and exit blocks.
+  HBasicBlock* InitMainBlock() {
+    CreateGraph();
+    AdjacencyListGraph blocks(
+        graph_, GetAllocator(), "entry", "exit", {{"entry", "main"}, {"main", "exit"}});
+    HBasicBlock* entry = blocks.Get("entry");
+    object_param_ = MakeParam(DataType::Type::kReference);
+    int_param_ = MakeParam(DataType::Type::kInt32);
+    suspend_check_ = new (GetAllocator()) HSuspendCheck();
+    entry->AddInstruction(suspend_check_);
+    entry->AddInstruction(new (GetAllocator()) HGoto());
+    ManuallyBuildEnvFor(suspend_check_, {});
+    SetupExit(blocks.Get("exit"));
+    graph_->SetHasMonitorOperations(true);
+    return blocks.Get("main");
+  }
+
+  HMonitorOperation* MakeMonitor(HInstruction* object, HMonitorOperation::OperationKind kind) {
+    return new (GetAllocator()) HMonitorOperation(object, kind, /* dex_pc= */ 0u);
+  }
+
+  void AddWithEnvironment(HBasicBlock* block, HInstruction* instruction) {
+    block->AddInstruction(instruction);
+    instruction->CopyEnvironmentFrom(suspend_check_->GetEnvironment());
+  }
+
+  bool PerformMonitorElimination() {
+    graph_->ClearDominanceInformation();
+    graph_->BuildDominatorTree();
+    bool result = MonitorElimination(graph_, /* stats= */ nullptr).Run();
+    EXPECT_TRUE(CheckGraphSkipRefTypeInfoChecks());
+    return result;
+  }
+
+  HInstruction* object_param_ = nullptr;
+  HInstruction* int_param_ = nullptr;
+  HInstruction* suspend_check_ = nullptr;
+};
+
+TEST_F(MonitorEliminationTest, ElideNonEscaping) {
+  HBasicBlock* main = InitMainBlock();
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* new_inst = MakeNewInstance(cls);
+  HMonitorOperation* enter = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kEnter);
+  HInstruction* set_field = MakeIFieldSet(new_inst, graph_->GetIntConstant(1), MemberOffset(32));
+  HMonitorOperation* exit = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kExit);
+  AddWithEnvironment(main, cls);
+  AddWithEnvironment(main, new_inst);
+  AddWithEnvironment(main, enter);
+  main->AddInstruction(set_field);
+  AddWithEnvironment(main, exit);
+  main->AddInstruction(new (GetAllocator()) HReturnVoid());
+
+  EXPECT_TRUE(PerformMonitorElimination());
+  EXPECT_INS_REMOVED(enter);
+  EXPECT_INS_REMOVED(exit);
+  EXPECT_INS_RETAINED(new_inst);
+}
+
+TEST_F(MonitorEliminationTest, KeepEscaping) {
+  HBasicBlock* main = InitMainBlock();
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* new_inst = MakeNewInstance(cls);
+  HMonitorOperation* enter = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kEnter);
+  HInstruction* call = MakeInvoke(DataType::Type::kVoid, {new_inst});
+  HMonitorOperation* exit = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kExit);
+  AddWithEnvironment(main, cls);
+  AddWithEnvironment(main, new_inst);
+  AddWithEnvironment(main, enter);
+  AddWithEnvironment(main, call);
+  AddWithEnvironment(main, exit);
+  main->AddInstruction(new (GetAllocator()) HReturnVoid());
+
+  EXPECT_FALSE(PerformMonitorElimination());
+  EXPECT_INS_RETAINED(enter);
+  EXPECT_INS_RETAINED(exit);
+}
+
+TEST_F(MonitorEliminationTest, KeepReturned) {
+  HBasicBlock* main = InitMainBlock();
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* new_inst = MakeNewInstance(cls);
+  HMonitorOperation* enter = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kEnter);
+  HMonitorOperation* exit = MakeMonitor(new_inst, HMonitorOperation::OperationKind::kExit);
+  AddWithEnvironment(main, cls);
+  AddWithEnvironment(main, new_inst);
+  AddWithEnvironment(main, enter);
+  AddWithEnvironment(main, exit);
+  main->AddInstruction(new (GetAllocator()) HReturn(new_inst));
+
+  EXPECT_FALSE(PerformMonitorElimination());
+  EXPECT_INS_RETAINED(enter);
+  EXPECT_INS_RETAINED(exit);
+}
+
+TEST_F(MonitorEliminationTest, CoarsenAdjacent) {
+  HBasicBlock* main = InitMainBlock();
+  HInstruction* param = object_param_;
+  HInstruction* value = int_param_;
+  HMonitorOperation* enter1 = MakeMonitor(param, HMonitorOperation::OperationKind::kEnter);
+  HMonitorOperation* exit1 = MakeMonitor(param, HMonitorOperation::OperationKind::kExit);
+  HInstruction* add = new (GetAllocator()) HAdd(DataType::Type::kInt32, value, value);
+  HMonitorOperation* enter2 = MakeMonitor(param, HMonitorOperation::OperationKind::kEnter);
+  HInstruction* set_field = MakeIFieldSet(param, add, MemberOffset(32));
+  HMonitorOperation* exit2 = MakeMonitor(param, HMonitorOperation::OperationKind::kExit);
+  AddWithEnvironment(main, enter1);
+  AddWithEnvironment(main, exit1);
+  main->AddInstruction(add);
+  AddWithEnvironment(main, enter2);
+  main->AddInstruction(set_field);
+  AddWithEnvironment(main, exit2);
+  main->AddInstruction(new (GetAllocator()) HReturnVoid());
+
+  EXPECT_TRUE(PerformMonitorElimination());
+  EXPECT_INS_RETAINED(enter1);
+  EXPECT_INS_REMOVED(exit1);
+  EXPECT_INS_REMOVED(enter2);
+  EXPECT_INS_RETAINED(exit2);
+}
+
+TEST_F(MonitorEliminationTest, NoCoarseningAcrossInvoke) {
+  HBasicBlock* main = InitMainBlock();
+  HInstruction* param = object_param_;
+  HMonitorOperation* enter1 = MakeMonitor(param, HMonitorOperation::OperationKind::kEnter);
+  HMonitorOperation* exit1 = MakeMonitor(param, HMonitorOperation::OperationKind::kExit);
+  HInstruction* call = MakeInvoke(DataType::Type::kVoid, {});
+  HMonitorOperation* enter2 = MakeMonitor(param, HMonitorOperation::OperationKind::kEnter);
+  HMonitorOperation* exit2 = MakeMonitor(param, HMonitorOperation::OperationKind::kExit);
+  AddWithEnvironment(main, enter1);
+  AddWithEnvironment(main, exit1);
+  AddWithEnvironment(main, call);
+  AddWithEnvironment(main, enter2);
+  AddWithEnvironment(main, exit2);
+  main->AddInstruction(new (GetAllocator()) HReturnVoid());
+
+  EXPECT_FALSE(PerformMonitorElimination());
+  EXPECT_INS_RETAINED(enter1);
+  EXPECT_INS_RETAINED(exit1);
+  EXPECT_INS_RETAINED(enter2);
+  EXPECT_INS_RETAINED(exit2);
+}
+
+}  // namespace art
@@ -414,6 +414,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         invoke_type_(invoke_type),
         in_ssa_form_(false),
         number_of_cha_guards_(0),
+        disabled_deoptimization_kinds_(0u),
         instruction_set_(instruction_set),
         cached_null_constant_(nullptr),
         cached_int_constants_(std::less<int32_t>(), allocator->Adapter(kArenaAllocConstantsMap)),
@@ -710,6 +711,15 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   void SetProfilingInfo(ProfilingInfo* info) { profiling_info_ = info; }
   ProfilingInfo* GetProfilingInfo() const { return profiling_info_; }
 
+  // Speculations guarded by an HDeoptimize of a disabled kind made previously
+  // compiled code for this method deoptimize too often, and must not be emitted.
+  bool IsDeoptimizationKindDisabled(DeoptimizationKind kind) const {
+    return (disabled_deoptimization_kinds_ & (1u << static_cast<uint32_t>(kind))) != 0u;
+  }
+  void DisableDeoptimizationKind(DeoptimizationKind kind) {
+    disabled_deoptimization_kinds_ |= 1u << static_cast<uint32_t>(kind);
+  }
+
   // Returns an instruction with the opposite Boolean value from 'cond'.
   // The instruction has been inserted into the graph, either as a constant, or
   // before cursor.
@@ -860,6 +870,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // CHA guard optimization pass when there is no CHA guard left.
   uint32_t number_of_cha_guards_;
 
+  // Bit mask of `DeoptimizationKind`s that optimizations must not generate.
+  uint32_t disabled_deoptimization_kinds_;
+
   const InstructionSet instruction_set_;
 
   // Cached constants.
@@ -1599,7 +1612,9 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(VecShl, VecBinaryOperation)                                         \
   M(VecShr, VecBinaryOperation)                                         \
   M(VecUShr, VecBinaryOperation)                                        \
+  M(VecCondition, VecBinaryOperation)                                   \
   M(VecSetScalars, VecOperation)                                        \
+  M(VecSelect, VecOperation)                                            \
   M(VecMultiplyAccumulate, VecOperation)                                \
   M(VecSADAccumulate, VecOperation)                                     \
   M(VecDotProd, VecOperation)                                           \
@@ -959,6 +959,54 @@ class HVecUShr final : public HVecBinaryOperation {
   DEFAULT_COPY_CONSTRUCTOR(VecUShr);
 };
 
+// Compares every component in the two vectors, setting all bits of a component of the
+// resulting mask when the condition holds and clearing them otherwise,
+// viz. [ x1, .. , xn ] cond [ y1, .. , yn ] = [ x1 cond y1 ? ~0 : 0, .. , xn cond yn ? ~0 : 0 ].
+// Only the kCondEQ and kCondGT signed comparisons are represented; the other conditions are
+// obtained by swapping the operands or the values selected with the mask (see HVecSelect).
+class HVecCondition final : public HVecBinaryOperation {
+ public:
+  HVecCondition(ArenaAllocator* allocator,
+                HInstruction* left,
+                HInstruction* right,
+                IfCondition condition,
+                DataType::Type packed_type,
+                size_t vector_length,
+                uint32_t dex_pc)
+      : HVecBinaryOperation(
+            kVecCondition, allocator, left, right, packed_type, vector_length, dex_pc) {
+    DCHECK(HasConsistentPackedTypes(left, packed_type));
+    DCHECK(HasConsistentPackedTypes(right, packed_type));
+    DCHECK(condition == kCondEQ || condition == kCondGT);
+    SetPackedField<ConditionField>(condition);
+  }
+
+  IfCondition GetCondition() const { return GetPackedField<ConditionField>(); }
+
+  bool CanBeMoved() const override { return true; }
+
+  bool InstructionDataEquals(const HInstruction* other) const override {
+    DCHECK(other->IsVecCondition());
+    const HVecCondition* o = other->AsVecCondition();
+    return HVecOperation::InstructionDataEquals(o) && GetCondition() == o->GetCondition();
+  }
+
+  DECLARE_INSTRUCTION(VecCondition);
+
+ protected:
+  DEFAULT_COPY_CONSTRUCTOR(VecCondition);
+
+ private:
+  // Additional packed bits.
+  static constexpr size_t kFieldCondition = HVecOperation::kNumberOfVectorOpPackedBits;
+  static constexpr size_t kFieldConditionSize =
+      MinimumBitsToStore(static_cast<size_t>(kCondLast));
+  static constexpr size_t kNumberOfVecConditionPackedBits = kFieldCondition + kFieldConditionSize;
+  static_assert(kNumberOfVecConditionPackedBits <= kMaxNumberOfPackedBits,
+                "Too many packed fields.");
+  using ConditionField = BitField<IfCondition, kFieldCondition, kFieldConditionSize>;
+};
+
 //
 // Definitions of concrete miscellaneous vector operations in HIR.
 //
@@ -997,6 +1045,47 @@ class HVecSetScalars final : public HVecOperation {
   DEFAULT_COPY_CONSTRUCTOR(VecSetScalars);
 };
 
+// Selects every component from either of two vectors according to a mask computed by
+// HVecCondition, viz. select([ m1, .. , mn ], [ x1, .. , xn ], [ y1, .. , yn ]) =
+// [ m1 ? x1 : y1, .. , mn ? xn : yn ].
+class HVecSelect final : public HVecOperation {
+ public:
+  HVecSelect(ArenaAllocator* allocator,
+             HInstruction* mask,
+             HInstruction* true_value,
+             HInstruction* false_value,
+             DataType::Type packed_type,
+             size_t vector_length,
+             uint32_t dex_pc)
+      : HVecOperation(kVecSelect,
+                      allocator,
+                      packed_type,
+                      SideEffects::None(),
+                      /* number_of_inputs= */ 3,
+                      vector_length,
+                      dex_pc) {
+    DCHECK(mask->IsVecCondition());
+    DCHECK_EQ(DataType::Size(mask->AsVecOperation()->GetPackedType()),
+              DataType::Size(packed_type));
+    DCHECK(HasConsistentPackedTypes(true_value, packed_type));
+    DCHECK(HasConsistentPackedTypes(false_value, packed_type));
+    SetRawInputAt(0, mask);
+    SetRawInputAt(1, true_value);
+    SetRawInputAt(2, false_value);
+  }
+
+  HInstruction* GetMask() const { return InputAt(0); }
+  HInstruction* GetTrueValue() const { return InputAt(1); }
+  HInstruction* GetFalseValue() const { return InputAt(2); }
+
+  bool CanBeMoved() const override { return true; }
+
+  DECLARE_INSTRUCTION(VecSelect);
+
+ protected:
+  DEFAULT_COPY_CONSTRUCTOR(VecSelect);
+};
+
 // Multiplies every component in the two vectors, adds the result vector to the accumulator vector,
 // viz. [ a1, .. , an ] + [ x1, .. , xn ] * [ y1, .. , yn ] = [ a1 + x1 * y1, .. , an + xn * yn ].
 // For floating point types, Java rounding behavior must be preserved; the products are rounded to
@@ -109,6 +109,9 @@ class PassObserver : public ValueObject {
         cached_method_name_(),
         timing_logger_enabled_(compiler_options.GetDumpPassTimings()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
+        pass_start_arena_bytes_(0u),
+        pass_start_arena_stack_peak_(0u),
+        arena_usage_oss_(),
         disasm_info_(graph->GetAllocator()),
         visualizer_oss_(),
         visualizer_output_(visualizer_output),
@@ -131,6 +134,8 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       LOG(INFO) << "TIMINGS " << GetMethodName();
       LOG(INFO) << Dumpable<TimingLogger>(timing_logger_);
+      LOG(INFO) << "ARENA USAGE " << GetMethodName();
+      LOG(INFO) << arena_usage_oss_.str();
     }
     if (visualizer_enabled_) {
       FlushVisualizer();
@@ -164,6 +169,8 @@ class PassObserver : public ValueObject {
       FlushVisualizer();
     }
     if (timing_logger_enabled_) {
+      pass_start_arena_bytes_ = graph_->GetAllocator()->BytesUsed();
+      pass_start_arena_stack_peak_ = graph_->GetArenaStack()->ApproximatePeakBytes();
       timing_logger_.StartTiming(pass_name);
     }
   }
@@ -179,6 +186,16 @@ class PassObserver : public ValueObject {
     // Pause timer first, then dump graph.
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
+      // Memory allocated in the graph's arena is kept until the end of the compilation,
+      // while the arena stack is reused by passes for their local data structures. Its
+      // peak is a high-water mark over the whole compilation, so report how much the pass
+      // raised it rather than the pass's own peak, which may be below the mark.
+      arena_usage_oss_ << pass_name << ": "
+                       << (graph_->GetAllocator()->BytesUsed() - pass_start_arena_bytes_)
+                       << " bytes allocated, arena stack peak raised by "
+                       << (graph_->GetArenaStack()->ApproximatePeakBytes() -
+                           pass_start_arena_stack_peak_)
+                       << " bytes\n";
     }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
@@ -225,6 +242,9 @@ class PassObserver : public ValueObject {
 
   bool timing_logger_enabled_;
   TimingLogger timing_logger_;
+  size_t pass_start_arena_bytes_;
+  size_t pass_start_arena_stack_peak_;
+  std::ostringstream arena_usage_oss_;
 
   DisassemblyInformation disasm_info_;
 
@@ -326,7 +346,17 @@ class OptimizingCompiler final : public Compiler {
     pass_changes[static_cast<size_t>(OptimizationPass::kNone)] = true;
     bool change = false;
     for (size_t i = 0; i < length; ++i) {
-      if (pass_changes[static_cast<size_t>(definitions[i].depends_on)]) {
+      if (!pass_changes[static_cast<size_t>(definitions[i].depends_on)]) {
+        // Skip the pass and record that nothing changed.
+        pass_changes[static_cast<size_t>(definitions[i].pass)] = false;
+      } else if (IsExpensivePass(definitions[i].pass) && IsOverOptimizationBudget(graph)) {
+        // Degrade to the pipeline without the expensive passes, and record that
+        // nothing changed.
+        VLOG(compiler) << "Skipping " << optimizations[i]->GetPassName() << " in "
+                       << pass_observer->GetMethodName() << ": over the optimization budget";
+        MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kPassSkippedOverBudget);
+        pass_changes[static_cast<size_t>(definitions[i].pass)] = false;
+      } else {
         // Execute the pass and record whether it changed anything.
         PassScope scope(optimizations[i]->GetPassName(), pass_observer);
         bool pass_change = optimizations[i]->Run();
@@ -336,14 +366,27 @@ class OptimizingCompiler final : public Compiler {
         } else {
           scope.SetPassNotChanged();
         }
-      } else {
-        // Skip the pass and record that nothing changed.
-        pass_changes[static_cast<size_t>(definitions[i].pass)] = false;
       }
     }
     return change;
   }
 
+  // Passes whose compile time grows faster than the size of the graph.
+  static bool IsExpensivePass(OptimizationPass pass) {
+    return pass == OptimizationPass::kInliner ||
+           pass == OptimizationPass::kLoadStoreElimination ||
+           pass == OptimizationPass::kLoopOptimization;
+  }
+
+  // Estimate the work of an expensive pass from the number of blocks and instructions
+  // of the graph. Instruction ids are not reused, so this is an upper bound once
+  // passes have removed instructions.
+  bool IsOverOptimizationBudget(HGraph* graph) const {
+    size_t estimated_work =
+        graph->GetBlocks().size() * static_cast<size_t>(graph->GetCurrentInstructionId());
+    return GetCompilerOptions().IsOverOptimizationBudget(estimated_work);
+  }
+
   template <size_t length> bool RunOptimizations(
       HGraph* graph,
       CodeGenerator* codegen,
@@ -558,6 +601,9 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86_64),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+        // Schedule before memory operand generation, which relies on the
+        // order of array lengths and bounds checks.
+        OptDef(OptimizationPass::kScheduling),
         OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
       return RunOptimizations(graph,
@@ -599,6 +645,26 @@ static void AllocateRegisters(HGraph* graph,
   }
 }
 
+// Disable the speculations that made previously compiled code for the method
+// deoptimize repeatedly, to avoid recompiling into the same deoptimization loop.
+static void DisableFailingSpeculations(HGraph* graph,
+                                       const ProfilingInfo* info,
+                                       OptimizingCompilerStats* stats) {
+  for (size_t i = 0; i <= static_cast<size_t>(DeoptimizationKind::kLast); ++i) {
+    DeoptimizationKind kind = static_cast<DeoptimizationKind>(i);
+    if (kind == DeoptimizationKind::kDebugging || kind == DeoptimizationKind::kFullFrame) {
+      // Not a speculation of the compiler.
+      continue;
+    }
+    if (info->GetDeoptimizationCount(kind) >= ProfilingInfo::kDeoptimizationFeedbackThreshold) {
+      VLOG(jit) << "Disabling " << GetDeoptimizationKindName(kind) << " deoptimizations for "
+                << graph->PrettyMethod();
+      graph->DisableDeoptimizationKind(kind);
+      MaybeRecordStat(stats, MethodCompilationStat::kDeoptimizationKindDisabled);
+    }
+  }
+}
+
 // Strip pass name suffix to get optimization name.
 static std::string ConvertPassNameToOptimizationName(const std::string& pass_name) {
   size_t pos = pass_name.find(kPassNameSeparator);
@@ -671,7 +737,9 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
            "constant_folding$after_bce"),
     OptDef(OptimizationPass::kAggressiveInstructionSimplifier,
            "instruction_simplifier$after_bce"),
-    // Other high-level optimizations.
+    // Other high-level optimizations. Eliding monitors on non-escaping objects
+    // before LSE lets LSE remove the allocations.
+    OptDef(OptimizationPass::kMonitorElimination),
     OptDef(OptimizationPass::kLoadStoreElimination),
     OptDef(OptimizationPass::kCHAGuardOptimization),
     OptDef(OptimizationPass::kDeadCodeElimination,
@@ -820,6 +888,9 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     DCHECK_IMPLIES(compilation_kind == CompilationKind::kBaseline, info != nullptr)
         << "Compiling a method baseline should always have a ProfilingInfo";
     graph->SetProfilingInfo(info);
+    if (info != nullptr && compilation_kind != CompilationKind::kBaseline) {
+      DisableFailingSpeculations(graph, info, compilation_stats_.get());
+    }
   }
 
   std::unique_ptr<CodeGenerator> codegen(
@@ -36,6 +36,7 @@ enum class MethodCompilationStat {
   kCompiledIntrinsic,
   kCompiledBytecode,
   kCHAInline,
+  kCHADevirtualizedInterface,
   kInlinedInvoke,
   kInlinedLastInvoke,
   kReplacedInvokeWithSimplePattern,
@@ -61,6 +62,7 @@ enum class MethodCompilationStat {
   kNotCompiledUnsupportedIsa,
   kNotCompiledIrreducibleLoopAndStringInit,
   kNotCompiledPhiEquivalentInOsr,
+  kNotCompiledOverBudget,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
   kMonomorphicCall,
@@ -122,6 +124,12 @@ enum class MethodCompilationStat {
   kPredicatedLoadAdded,
   kPredicatedStoreAdded,
   kDevirtualized,
+  kDeoptimizationKindDisabled,
+  kMonitorOperationElided,
+  kMonitorOperationCoarsened,
+  kLoadThroughPhiSplit,
+  kPassSkippedOverBudget,
+  kLoopStoreSunk,
   kLastStat
 };
 std::ostream& operator<<(std::ostream& os, MethodCompilationStat rhs);
@@ -29,6 +29,16 @@
 
 namespace art {
 
+// We always want to avoid spilling inside loops.
+static constexpr size_t kLoopSpillWeightMultiplier = 10;
+
+// If we avoid moves in single jump blocks, we can avoid jumps to jumps.
+static constexpr size_t kSingleJumpBlockWeightMultiplier = 2;
+
+// We avoid moves in blocks that dominate the exit block, since these blocks will
+// be executed on every path through the method.
+static constexpr size_t kDominatesExitBlockWeightMultiplier = 2;
+
 RegisterAllocator::RegisterAllocator(ScopedArenaAllocator* allocator,
                                      CodeGenerator* codegen,
                                      const SsaLivenessAnalysis& liveness)
@@ -47,6 +57,9 @@ std::unique_ptr<RegisterAllocator> RegisterAllocator::Create(ScopedArenaAllocato
     case kRegisterAllocatorGraphColor:
       return std::unique_ptr<RegisterAllocator>(
           new (allocator) RegisterAllocatorGraphColor(allocator, codegen, analysis));
+    case kRegisterAllocatorLinearScanWeighted:
+      return std::unique_ptr<RegisterAllocator>(new (allocator) RegisterAllocatorLinearScan(
+          allocator, codegen, analysis, /* use_loop_weights= */ true));
     default:
       LOG(FATAL) << "Invalid register allocation strategy: " << strategy;
       UNREACHABLE();
@@ -68,6 +81,36 @@ RegisterAllocator::~RegisterAllocator() {
   }
 }
 
+static size_t LoopDepthAt(HBasicBlock* block) {
+  HLoopInformation* loop_info = block->GetLoopInformation();
+  size_t depth = 0;
+  while (loop_info != nullptr) {
+    ++depth;
+    loop_info = loop_info->GetPreHeader()->GetLoopInformation();
+  }
+  return depth;
+}
+
+size_t RegisterAllocator::CostForMoveIn(HBasicBlock* block) {
+  size_t cost = 1;
+  if (block->IsSingleJump()) {
+    cost *= kSingleJumpBlockWeightMultiplier;
+  }
+  if (block->Dominates(block->GetGraph()->GetExitBlock())) {
+    cost *= kDominatesExitBlockWeightMultiplier;
+  }
+  for (size_t loop_depth = LoopDepthAt(block); loop_depth > 0; --loop_depth) {
+    cost *= kLoopSpillWeightMultiplier;
+  }
+  return cost;
+}
+
+size_t RegisterAllocator::CostForMoveAt(size_t position, const SsaLivenessAnalysis& liveness) {
+  HBasicBlock* block = liveness.GetBlockFromPosition(position / 2);
+  DCHECK(block != nullptr);
+  return CostForMoveIn(block);
+}
+
 class AllRangesIterator : public ValueObject {
  public:
   explicit AllRangesIterator(LiveInterval* interval)
@@ -229,6 +272,10 @@ LiveInterval* RegisterAllocator::Split(LiveInterval* interval, size_t position)
 }
 
 LiveInterval* RegisterAllocator::SplitBetween(LiveInterval* interval, size_t from, size_t to) {
+  return Split(interval, FindSplitPositionBetween(from, to));
+}
+
+size_t RegisterAllocator::FindSplitPositionBetween(size_t from, size_t to) const {
   HBasicBlock* block_from = liveness_.GetBlockFromPosition(from / 2);
   HBasicBlock* block_to = liveness_.GetBlockFromPosition(to / 2);
   DCHECK(block_from != nullptr);
@@ -236,7 +283,7 @@ LiveInterval* RegisterAllocator::SplitBetween(LiveInterval* interval, size_t fro
 
   // Both locations are in the same block. We split at the given location.
   if (block_from == block_to) {
-    return Split(interval, to);
+    return to;
   }
 
   /*
@@ -284,7 +331,7 @@ LiveInterval* RegisterAllocator::SplitBetween(LiveInterval* interval, size_t fro
 
   // Split at the start of the found block, to piggy back on existing moves
   // due to resolution if non-linear control flow (see `ConnectSplitSiblings`).
-  return Split(interval, block_to->GetLifetimeStart());
+  return block_to->GetLifetimeStart();
 }
 
 }  // namespace art
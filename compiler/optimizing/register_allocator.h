@@ -40,7 +40,9 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
  public:
   enum Strategy {
     kRegisterAllocatorLinearScan,
-    kRegisterAllocatorGraphColor
+    kRegisterAllocatorGraphColor,
+    // Linear scan that weights spill and reload costs by loop depth.
+    kRegisterAllocatorLinearScanWeighted
   };
 
   static constexpr Strategy kRegisterAllocatorDefault = kRegisterAllocatorLinearScan;
@@ -68,6 +70,12 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
                                 bool processing_core_registers,
                                 bool log_fatal_on_failure);
 
+  // Return the estimated runtime cost of inserting a move instruction in `block`.
+  static size_t CostForMoveIn(HBasicBlock* block);
+
+  // Return the estimated runtime cost of inserting a move instruction at `position`.
+  static size_t CostForMoveAt(size_t position, const SsaLivenessAnalysis& liveness);
+
   static constexpr const char* kRegisterAllocatorPassName = "register";
 
  protected:
@@ -84,6 +92,9 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
   // to find an optimal split position.
   LiveInterval* SplitBetween(LiveInterval* interval, size_t from, size_t to);
 
+  // Return the position `SplitBetween` would split an interval at.
+  size_t FindSplitPositionBetween(size_t from, size_t to) const;
+
   ScopedArenaAllocator* const allocator_;
   CodeGenerator* const codegen_;
   const SsaLivenessAnalysis& liveness_;
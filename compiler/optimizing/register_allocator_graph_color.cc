@@ -38,16 +38,6 @@ static constexpr size_t kMaxNumRegs = 32;
 // intervals are split when coloring fails.
 static constexpr size_t kMaxGraphColoringAttemptsDebug = 100;
 
-// We always want to avoid spilling inside loops.
-static constexpr size_t kLoopSpillWeightMultiplier = 10;
-
-// If we avoid moves in single jump blocks, we can avoid jumps to jumps.
-static constexpr size_t kSingleJumpBlockWeightMultiplier = 2;
-
-// We avoid moves in blocks that dominate the exit block, since these blocks will
-// be executed on every path through the method.
-static constexpr size_t kDominatesExitBlockWeightMultiplier = 2;
-
 enum class CoalesceKind {
   kAdjacentSibling,       // Prevents moves at interval split points.
   kFixedOutputSibling,    // Prevents moves from a fixed output location.
@@ -62,33 +52,6 @@ std::ostream& operator<<(std::ostream& os, const CoalesceKind& kind) {
   return os << static_cast<typename std::underlying_type<CoalesceKind>::type>(kind);
 }
 
-static size_t LoopDepthAt(HBasicBlock* block) {
-  HLoopInformation* loop_info = block->GetLoopInformation();
-  size_t depth = 0;
-  while (loop_info != nullptr) {
-    ++depth;
-    loop_info = loop_info->GetPreHeader()->GetLoopInformation();
-  }
-  return depth;
-}
-
-// Return the runtime cost of inserting a move instruction at the specified location.
-static size_t CostForMoveAt(size_t position, const SsaLivenessAnalysis& liveness) {
-  HBasicBlock* block = liveness.GetBlockFromPosition(position / 2);
-  DCHECK(block != nullptr);
-  size_t cost = 1;
-  if (block->IsSingleJump()) {
-    cost *= kSingleJumpBlockWeightMultiplier;
-  }
-  if (block->Dominates(block->GetGraph()->GetExitBlock())) {
-    cost *= kDominatesExitBlockWeightMultiplier;
-  }
-  for (size_t loop_depth = LoopDepthAt(block); loop_depth > 0; --loop_depth) {
-    cost *= kLoopSpillWeightMultiplier;
-  }
-  return cost;
-}
-
 // In general, we estimate coalesce priority by whether it will definitely avoid a move,
 // and by how likely it is to create an interference graph that's harder to color.
 static size_t ComputeCoalescePriority(CoalesceKind kind,
@@ -99,7 +62,7 @@ static size_t ComputeCoalescePriority(CoalesceKind kind,
     // give it the lowest priority.
     return 0;
   } else {
-    return CostForMoveAt(position, liveness);
+    return RegisterAllocator::CostForMoveAt(position, liveness);
   }
 }
 
@@ -175,7 +138,7 @@ static float ComputeSpillWeight(LiveInterval* interval, const SsaLivenessAnalysi
   size_t use_weight = 0;
   if (interval->GetDefinedBy() != nullptr && interval->DefinitionRequiresRegister()) {
     // Cost for spilling at a register definition point.
-    use_weight += CostForMoveAt(interval->GetStart() + 1, liveness);
+    use_weight += RegisterAllocator::CostForMoveAt(interval->GetStart() + 1, liveness);
   }
 
   // Process uses in the range (interval->GetStart(), interval->GetEnd()], i.e.
@@ -187,7 +150,8 @@ static float ComputeSpillWeight(LiveInterval* interval, const SsaLivenessAnalysi
   for (const UsePosition& use : matching_use_range) {
     if (use.GetUser() != nullptr && use.RequiresRegister()) {
       // Cost for spilling at a register use point.
-      use_weight += CostForMoveAt(use.GetUser()->GetLifetimePosition() - 1, liveness);
+      use_weight +=
+          RegisterAllocator::CostForMoveAt(use.GetUser()->GetLifetimePosition() - 1, liveness);
     }
   }
 
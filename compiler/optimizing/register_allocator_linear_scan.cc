@@ -16,6 +16,7 @@
 
 #include "register_allocator_linear_scan.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -42,7 +43,8 @@ static bool IsLowOfUnalignedPairInterval(LiveInterval* low) {
 
 RegisterAllocatorLinearScan::RegisterAllocatorLinearScan(ScopedArenaAllocator* allocator,
                                                          CodeGenerator* codegen,
-                                                         const SsaLivenessAnalysis& liveness)
+                                                         const SsaLivenessAnalysis& liveness,
+                                                         bool use_loop_weights)
       : RegisterAllocator(allocator, codegen, liveness),
         unhandled_core_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
         unhandled_fp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
@@ -64,7 +66,12 @@ RegisterAllocatorLinearScan::RegisterAllocatorLinearScan(ScopedArenaAllocator* a
         registers_array_(nullptr),
         blocked_core_registers_(codegen->GetBlockedCoreRegisters()),
         blocked_fp_registers_(codegen->GetBlockedFloatingPointRegisters()),
-        reserved_out_slots_(0) {
+        reserved_out_slots_(0),
+        use_loop_weights_(use_loop_weights),
+        cold_blocks_(allocator,
+                     use_loop_weights ? codegen->GetGraph()->GetBlocks().size() : 0u,
+                     /* expandable= */ false,
+                     kArenaAllocRegisterAllocator) {
   temp_intervals_.reserve(4);
   int_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
   long_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
@@ -163,6 +170,10 @@ void RegisterAllocatorLinearScan::BlockRegisters(size_t start, size_t end, bool
 }
 
 void RegisterAllocatorLinearScan::AllocateRegistersInternal() {
+  if (use_loop_weights_) {
+    ComputeColdBlocks();
+  }
+
   // Iterate post-order, to ensure the list is sorted, and the last added interval
   // is the one with the lowest start position.
   for (HBasicBlock* block : codegen_->GetGraph()->GetLinearPostOrder()) {
@@ -814,6 +825,17 @@ int RegisterAllocatorLinearScan::FindAvailableRegister(size_t* next_use, LiveInt
   // register if one is available. We iterate from 0 to the number of registers,
   // so if there are caller-save registers available at the end, we continue the iteration.
   bool prefers_caller_save = !current->HasWillCallSafepoint();
+  // With loop weights, an interval that only spans calls on cold paths also prefers a
+  // caller-save register that is available until the first of these calls. The interval
+  // will then be split around the call, keeping the moves on the cold path.
+  size_t caller_save_available_until = kMaxLifetimePosition;
+  if (!prefers_caller_save && use_loop_weights_) {
+    size_t cold_call_position = FirstColdCallPosition(current);
+    if (cold_call_position != kNoLifetime) {
+      prefers_caller_save = true;
+      caller_save_available_until = cold_call_position;
+    }
+  }
   int reg = kNoRegister;
   for (size_t i = 0; i < number_of_registers_; ++i) {
     if (IsBlocked(i)) {
@@ -822,7 +844,8 @@ int RegisterAllocatorLinearScan::FindAvailableRegister(size_t* next_use, LiveInt
     }
 
     // Best case: we found a register fully available.
-    if (next_use[i] == kMaxLifetimePosition) {
+    if (next_use[i] == kMaxLifetimePosition ||
+        (IsCallerSaveRegister(i) && next_use[i] >= caller_save_available_until)) {
       if (prefers_caller_save && !IsCallerSaveRegister(i)) {
         // We can get shorter encodings on some platforms by using
         // small register numbers. So only update the candidate if the previous
@@ -854,6 +877,88 @@ int RegisterAllocatorLinearScan::FindAvailableRegister(size_t* next_use, LiveInt
   return reg;
 }
 
+int RegisterAllocatorLinearScan::FindCheapestRegisterToSpill(size_t* next_use,
+                                                             LiveInterval* current,
+                                                             size_t first_register_use,
+                                                             bool* should_spill) const {
+  size_t start = current->GetStart();
+  int reg = kNoRegister;
+  size_t reg_cost = 0u;
+  for (size_t i = 0; i < number_of_registers_; ++i) {
+    if (IsBlocked(i) || next_use[i] <= first_register_use) {
+      continue;
+    }
+    // A holder without further register uses does not need to be reloaded.
+    size_t cost = (next_use[i] == kMaxLifetimePosition)
+        ? 0u
+        : ReloadCostBetween(start, std::max(start, next_use[i] - 1));
+    // On equal costs, pick the register that is used the last.
+    if (reg == kNoRegister ||
+        cost < reg_cost ||
+        (cost == reg_cost && next_use[i] > next_use[reg])) {
+      reg = i;
+      reg_cost = cost;
+    }
+  }
+
+  if (reg == kNoRegister) {
+    *should_spill = true;
+    return FindAvailableRegister(next_use, current);
+  }
+  // Spill `current` if its own reload is cheaper, e.g. when it is defined before
+  // a loop that needs the other registers and only used after it. This needs a
+  // split position before its first register use.
+  bool is_allocation_at_use_site = (start >= (first_register_use - 1));
+  *should_spill =
+      !is_allocation_at_use_site && ReloadCostBetween(start, first_register_use - 1) < reg_cost;
+  return reg;
+}
+
+size_t RegisterAllocatorLinearScan::ReloadCostBetween(size_t from, size_t to) const {
+  size_t position = FindSplitPositionBetween(from, to);
+  HBasicBlock* block = liveness_.GetBlockFromPosition(position / 2);
+  DCHECK(block != nullptr);
+  if (block->IsLoopHeader() && position == block->GetLifetimeStart() && from < position) {
+    // Splitting at a loop header from outside the loop moves the interval on
+    // the loop entry edge only.
+    return CostForMoveIn(block->GetLoopInformation()->GetPreHeader());
+  }
+  return CostForMoveIn(block);
+}
+
+void RegisterAllocatorLinearScan::ComputeColdBlocks() {
+  // Visit successors before predecessors. Successors reached through a back edge
+  // are not visited yet, which conservatively keeps loops out of the cold set.
+  for (HBasicBlock* block : codegen_->GetGraph()->GetPostOrder()) {
+    if (block->IsExitBlock()) {
+      continue;
+    }
+    ArrayRef<HBasicBlock* const> successors = block->GetNormalSuccessors();
+    if (block->GetLastInstruction()->IsThrow() ||
+        (!successors.empty() &&
+         std::all_of(successors.begin(), successors.end(), [&](HBasicBlock* successor) {
+           return cold_blocks_.IsBitSet(successor->GetBlockId());
+         }))) {
+      cold_blocks_.SetBit(block->GetBlockId());
+    }
+  }
+}
+
+size_t RegisterAllocatorLinearScan::FirstColdCallPosition(LiveInterval* interval) const {
+  size_t position = kNoLifetime;
+  for (SafepointPosition* safepoint = interval->GetFirstSafepoint();
+       safepoint != nullptr;
+       safepoint = safepoint->GetNext()) {
+    if (safepoint->GetLocations()->WillCall()) {
+      if (!cold_blocks_.IsBitSet(safepoint->GetInstruction()->GetBlock()->GetBlockId())) {
+        return kNoLifetime;
+      }
+      position = std::min(position, safepoint->GetPosition());
+    }
+  }
+  return position;
+}
+
 // Remove interval and its other half if any. Return iterator to the following element.
 static ArenaVector<LiveInterval*>::iterator RemoveIntervalAndPotentialOtherHalf(
     ScopedArenaVector<LiveInterval*>* intervals, ScopedArenaVector<LiveInterval*>::iterator pos) {
@@ -980,6 +1085,9 @@ bool RegisterAllocatorLinearScan::AllocateBlockedReg(LiveInterval* current) {
     // We should spill if both registers are not available.
     should_spill = (first_register_use >= next_use[reg])
       || (first_register_use >= next_use[GetHighForLowRegister(reg)]);
+  } else if (use_loop_weights_) {
+    DCHECK(!current->IsHighInterval());
+    reg = FindCheapestRegisterToSpill(next_use, current, first_register_use, &should_spill);
   } else {
     DCHECK(!current->IsHighInterval());
     reg = FindAvailableRegister(next_use, current);
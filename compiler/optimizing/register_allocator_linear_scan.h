@@ -18,6 +18,7 @@
 #define ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_LINEAR_SCAN_H_
 
 #include "arch/instruction_set.h"
+#include "base/arena_bit_vector.h"
 #include "base/macros.h"
 #include "base/scoped_arena_containers.h"
 #include "register_allocator.h"
@@ -36,12 +37,18 @@ class SsaLivenessAnalysis;
 
 /**
  * An implementation of a linear scan register allocator on an `HGraph` with SSA form.
+ *
+ * When `use_loop_weights` is set, the allocator estimates where the moves caused by
+ * splitting an interval will land, and prefers to spill intervals whose reloads are
+ * outside of loops. Intervals that are only live across calls on paths that always
+ * throw are allocated to caller-save registers and split around these calls.
  */
 class RegisterAllocatorLinearScan : public RegisterAllocator {
  public:
   RegisterAllocatorLinearScan(ScopedArenaAllocator* allocator,
                               CodeGenerator* codegen,
-                              const SsaLivenessAnalysis& analysis);
+                              const SsaLivenessAnalysis& analysis,
+                              bool use_loop_weights = false);
   ~RegisterAllocatorLinearScan() override;
 
   void AllocateRegisters() override;
@@ -98,6 +105,25 @@ class RegisterAllocatorLinearScan : public RegisterAllocator {
   int FindAvailableRegister(size_t* next_use, LiveInterval* current) const;
   bool IsCallerSaveRegister(int reg) const;
 
+  // Find the register whose holder is the cheapest to spill, by the cost of reloading it
+  // at its next register use. Sets `should_spill` if spilling `current` is cheaper, or if
+  // no register is available before the first register use of `current`.
+  int FindCheapestRegisterToSpill(size_t* next_use,
+                                  LiveInterval* current,
+                                  size_t first_register_use,
+                                  bool* should_spill) const;
+
+  // Return the estimated cost of the move needed to reload an interval spilled at `from`
+  // that needs a register at `to`.
+  size_t ReloadCostBetween(size_t from, size_t to) const;
+
+  // Mark the blocks from which all paths end with a throw.
+  void ComputeColdBlocks();
+
+  // Return the position of the first call `interval` is live across if all such calls
+  // are in cold blocks, or kNoLifetime otherwise.
+  size_t FirstColdCallPosition(LiveInterval* interval) const;
+
   // If any inputs require specific registers, block those registers
   // at the position of this instruction.
   void CheckForFixedInputs(HInstruction* instruction);
@@ -193,8 +219,15 @@ class RegisterAllocatorLinearScan : public RegisterAllocator {
   // Slots reserved for out arguments.
   size_t reserved_out_slots_;
 
+  // Whether spill decisions take loop depth and cold calls into account.
+  const bool use_loop_weights_;
+
+  // Blocks from which all paths end with a throw. Only computed when `use_loop_weights_`.
+  ArenaBitVector cold_blocks_;
+
   ART_FRIEND_TEST(RegisterAllocatorTest, FreeUntil);
   ART_FRIEND_TEST(RegisterAllocatorTest, SpillInactive);
+  ART_FRIEND_TEST(RegisterAllocatorTest, FindCheapestRegisterToSpill);
 
   DISALLOW_COPY_AND_ASSIGN(RegisterAllocatorLinearScan);
 };
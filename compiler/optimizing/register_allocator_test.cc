@@ -63,6 +63,7 @@ class RegisterAllocatorTest : public OptimizingUnitTest {
   HGraph* BuildFieldReturn(HInstruction** field, HInstruction** ret);
   HGraph* BuildTwoSubs(HInstruction** first_sub, HInstruction** second_sub);
   HGraph* BuildDiv(HInstruction** div);
+  HGraph* BuildColdCall(HInstruction** value, HInstruction** call);
   void ExpectedExactInRegisterAndSameOutputHint(Strategy strategy);
 
   bool ValidateIntervals(const ScopedArenaVector<LiveInterval*>& intervals,
@@ -85,6 +86,9 @@ TEST_F(RegisterAllocatorTest, test_name##_LinearScan) {\
 }\
 TEST_F(RegisterAllocatorTest, test_name##_GraphColor) {\
   test_name(Strategy::kRegisterAllocatorGraphColor);\
+}\
+TEST_F(RegisterAllocatorTest, test_name##_LinearScanWeighted) {\
+  test_name(Strategy::kRegisterAllocatorLinearScanWeighted);\
 }
 
 bool RegisterAllocatorTest::Check(const std::vector<uint16_t>& data, Strategy strategy) {
@@ -832,6 +836,209 @@ TEST_F(RegisterAllocatorTest, ExpectedExactInRegisterAndSameOutputHint_LinearSca
   ExpectedExactInRegisterAndSameOutputHint(Strategy::kRegisterAllocatorLinearScan);
 }
 
+HGraph* RegisterAllocatorTest::BuildColdCall(HInstruction** value, HInstruction** call) {
+  HGraph* graph = CreateGraph();
+  HBasicBlock* entry = new (GetAllocator()) HBasicBlock(graph);
+  graph->AddBlock(entry);
+  graph->SetEntryBlock(entry);
+  HInstruction* parameter = new (GetAllocator()) HParameterValue(
+      graph->GetDexFile(), dex::TypeIndex(0), 0, DataType::Type::kReference);
+  entry->AddInstruction(parameter);
+  *value = new (GetAllocator()) HInstanceFieldGet(parameter,
+                                                  nullptr,
+                                                  DataType::Type::kInt32,
+                                                  MemberOffset(42),
+                                                  false,
+                                                  kUnknownFieldIndex,
+                                                  kUnknownClassDefIndex,
+                                                  graph->GetDexFile(),
+                                                  0);
+  entry->AddInstruction(*value);
+
+  HBasicBlock* block = new (GetAllocator()) HBasicBlock(graph);
+  graph->AddBlock(block);
+  entry->AddSuccessor(block);
+  HInstruction* test = new (GetAllocator()) HInstanceFieldGet(parameter,
+                                                              nullptr,
+                                                              DataType::Type::kBool,
+                                                              MemberOffset(22),
+                                                              false,
+                                                              kUnknownFieldIndex,
+                                                              kUnknownClassDefIndex,
+                                                              graph->GetDexFile(),
+                                                              0);
+  block->AddInstruction(test);
+  block->AddInstruction(new (GetAllocator()) HIf(test));
+
+  HBasicBlock* throw_block = new (GetAllocator()) HBasicBlock(graph);
+  HBasicBlock* return_block = new (GetAllocator()) HBasicBlock(graph);
+  HBasicBlock* exit = new (GetAllocator()) HBasicBlock(graph);
+  graph->AddBlock(throw_block);
+  graph->AddBlock(return_block);
+  graph->AddBlock(exit);
+  block->AddSuccessor(throw_block);
+  block->AddSuccessor(return_block);
+  throw_block->AddSuccessor(exit);
+  return_block->AddSuccessor(exit);
+
+  // The throwing path divides two longs, which x86 does with a runtime call,
+  // and then stores `value`. `value` is only live across that call.
+  HInstruction* dividend = new (GetAllocator()) HInstanceFieldGet(parameter,
+                                                                  nullptr,
+                                                                  DataType::Type::kInt64,
+                                                                  MemberOffset(24),
+                                                                  false,
+                                                                  kUnknownFieldIndex,
+                                                                  kUnknownClassDefIndex,
+                                                                  graph->GetDexFile(),
+                                                                  0);
+  HInstruction* divisor = new (GetAllocator()) HInstanceFieldGet(parameter,
+                                                                 nullptr,
+                                                                 DataType::Type::kInt64,
+                                                                 MemberOffset(32),
+                                                                 false,
+                                                                 kUnknownFieldIndex,
+                                                                 kUnknownClassDefIndex,
+                                                                 graph->GetDexFile(),
+                                                                 0);
+  *call = new (GetAllocator()) HDiv(DataType::Type::kInt64, dividend, divisor, 0);
+  throw_block->AddInstruction(dividend);
+  throw_block->AddInstruction(divisor);
+  throw_block->AddInstruction(*call);
+  throw_block->AddInstruction(new (GetAllocator()) HInstanceFieldSet(parameter,
+                                                                     *value,
+                                                                     nullptr,
+                                                                     DataType::Type::kInt32,
+                                                                     MemberOffset(42),
+                                                                     false,
+                                                                     kUnknownFieldIndex,
+                                                                     kUnknownClassDefIndex,
+                                                                     graph->GetDexFile(),
+                                                                     0));
+  throw_block->AddInstruction(new (GetAllocator()) HThrow(parameter, 0));
+
+  return_block->AddInstruction(new (GetAllocator()) HReturnVoid());
+  exit->AddInstruction(new (GetAllocator()) HExit());
+
+  graph->BuildDominatorTree();
+  graph->AnalyzeLoops();
+  return graph;
+}
+
+/**
+ * Test that the weighted linear scan allocator gives a caller-save register to
+ * an interval that is only live across a call on a throwing path, and splits the
+ * interval before that call. The plain linear scan allocator gives it a callee-save
+ * register for its whole lifetime.
+ */
+TEST_F(RegisterAllocatorTest, ColdCallSplit) {
+  HInstruction *value, *call;
+
+  {
+    HGraph* graph = BuildColdCall(&value, &call);
+    x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
+    SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+    liveness.Analyze();
+
+    std::unique_ptr<RegisterAllocator> register_allocator = RegisterAllocator::Create(
+        GetScopedAllocator(), &codegen, liveness, Strategy::kRegisterAllocatorLinearScan);
+    register_allocator->AllocateRegisters();
+    ASSERT_TRUE(register_allocator->Validate(false));
+
+    LiveInterval* interval = value->GetLiveInterval();
+    ASSERT_TRUE(codegen.IsCoreCalleeSaveRegister(interval->GetRegister()));
+    ASSERT_EQ(interval->GetNextSibling(), nullptr);
+  }
+
+  {
+    HGraph* graph = BuildColdCall(&value, &call);
+    x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
+    SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+    liveness.Analyze();
+
+    std::unique_ptr<RegisterAllocator> register_allocator = RegisterAllocator::Create(
+        GetScopedAllocator(), &codegen, liveness, Strategy::kRegisterAllocatorLinearScanWeighted);
+    register_allocator->AllocateRegisters();
+    ASSERT_TRUE(register_allocator->Validate(false));
+
+    LiveInterval* interval = value->GetLiveInterval();
+    ASSERT_NE(interval->GetRegister(), kNoRegister);
+    ASSERT_FALSE(codegen.IsCoreCalleeSaveRegister(interval->GetRegister()));
+    ASSERT_NE(interval->GetNextSibling(), nullptr);
+    ASSERT_LE(interval->GetNextSibling()->GetStart(), call->GetLifetimePosition());
+  }
+}
+
+/**
+ * Test that the weighted linear scan allocator, when it needs a register inside a loop
+ * and all registers are taken, frees the register of a value only used after the loop
+ * and keeps the register of a value used in the loop.
+ */
+TEST_F(RegisterAllocatorTest, FindCheapestRegisterToSpill) {
+  /*
+   * Test the following snippet, as in Loop2:
+   *  int a = 0;
+   *  while (a == 8) {
+   *    a = 4 + 5;
+   *  }
+   *  return 6 + 7;
+   */
+  const std::vector<uint16_t> data = TWO_REGISTERS_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::CONST_4 | 8 << 12 | 1 << 8,
+    Instruction::IF_EQ | 1 << 8, 7,
+    Instruction::CONST_4 | 4 << 12 | 0 << 8,
+    Instruction::CONST_4 | 5 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::GOTO | 0xFA00,
+    Instruction::CONST_4 | 6 << 12 | 1 << 8,
+    Instruction::CONST_4 | 7 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::RETURN | 1 << 8);
+
+  HGraph* graph = CreateCFG(data);
+  x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
+  SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+  liveness.Analyze();
+
+  HInstruction* in_loop_add = nullptr;
+  HInstruction* after_loop_add = nullptr;
+  for (HBasicBlock* block : graph->GetLinearOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      if (it.Current()->IsAdd()) {
+        if (block->IsInLoop()) {
+          in_loop_add = it.Current();
+        } else {
+          after_loop_add = it.Current();
+        }
+      }
+    }
+  }
+  ASSERT_TRUE(in_loop_add != nullptr);
+  ASSERT_TRUE(after_loop_add != nullptr);
+
+  RegisterAllocatorLinearScan register_allocator(
+      GetScopedAllocator(), &codegen, liveness, /* use_loop_weights= */ true);
+  register_allocator.processing_core_registers_ = true;
+  register_allocator.number_of_registers_ = codegen.GetNumberOfCoreRegisters();
+
+  // Allocate a register for `4 + 5`. ECX holds a value next used at the end of the loop
+  // body, EDX holds a value next used after the loop, and the other registers are needed
+  // before the first register use of `4 + 5`.
+  LiveInterval* current = in_loop_add->GetLiveInterval();
+  size_t first_register_use = current->GetStart() + 1u;
+  std::vector<size_t> next_use(codegen.GetNumberOfCoreRegisters(), first_register_use);
+  next_use[x86::ECX] = in_loop_add->GetBlock()->GetLastInstruction()->GetLifetimePosition();
+  next_use[x86::EDX] = after_loop_add->GetLifetimePosition();
+  ASSERT_GT(next_use[x86::ECX], first_register_use);
+
+  bool should_spill = true;
+  int reg = register_allocator.FindCheapestRegisterToSpill(
+      next_use.data(), current, first_register_use, &should_spill);
+  ASSERT_EQ(reg, x86::EDX);
+  ASSERT_FALSE(should_spill);
+}
+
 // Test a bug in the register allocator, where allocating a blocked
 // register would lead to spilling an inactive interval at the wrong
 // position.
@@ -20,6 +20,8 @@
 #include <type_traits>
 
 #include "entrypoints/quick/quick_entrypoints.h"
+#include "indirect_reference_table.h"
+#include "jni/jni_env_ext.h"
 #include "lock_word.h"
 #include "thread.h"
 
@@ -1150,6 +1152,41 @@ void ArmVIXLJNIMacroAssembler::DeliverPendingException() {
   ___ Blx(lr);
 }
 
+void ArmVIXLJNIMacroAssembler::DecodeJNITransitionOrLocalReference(ManagedRegister mreg,
+                                                                   ManagedRegister mjni_env,
+                                                                   ManagedRegister mscratch,
+                                                                   JNIMacroLabel* slow_path,
+                                                                   JNIMacroLabel* resume) {
+  vixl32::Register reg = AsVIXLRegister(mreg.AsArm());
+  vixl32::Register jni_env = AsVIXLRegister(mjni_env.AsArm());
+  vixl32::Register scratch = AsVIXLRegister(mscratch.AsArm());
+  vixl32::Label* slow_path_label = ArmVIXLJNIMacroLabel::Cast(slow_path)->AsArm();
+  vixl32::Label* resume_label = ArmVIXLJNIMacroLabel::Cast(resume)->AsArm();
+  vixl32::Label local;
+  ___ CompareAndBranchIfZero(reg, resume_label);
+  asm_.LoadFromOffset(kLoadUnsignedByte,
+                      scratch,
+                      jni_env,
+                      JNIEnvExt::CheckJniOffset(kArmPointerSize).Int32Value());
+  ___ CompareAndBranchIfNonZero(scratch, slow_path_label);
+  ___ Tst(reg, IndirectReferenceTable::GetGlobalOrWeakGlobalMask());
+  ___ B(ne, slow_path_label);
+  ___ Tst(reg, IndirectReferenceTable::GetLocalMask());
+  ___ B(ne, &local);
+  // JNI transition reference, pointing to a `StackReference<>`.
+  asm_.LoadFromOffset(kLoadWord, reg, reg, 0);
+  ___ B(resume_label);
+  ___ Bind(&local);
+  // Local reference, load the `IrtEntry` reference from the current thread's local table.
+  asm_.LoadFromOffset(kLoadWord,
+                      scratch,
+                      jni_env,
+                      JNIEnvExt::LocalsTableOffset(kArmPointerSize).Int32Value());
+  ___ Lsr(reg, reg, IndirectReferenceTable::GetIndexShift());
+  ___ Add(scratch, scratch, Operand(reg, ShiftType::LSL, WhichPowerOf2(sizeof(IrtEntry))));
+  asm_.LoadFromOffset(kLoadWord, reg, scratch, IrtEntry::ReferenceOffset().Int32Value());
+}
+
 std::unique_ptr<JNIMacroLabel> ArmVIXLJNIMacroAssembler::CreateLabel() {
   return std::unique_ptr<JNIMacroLabel>(new ArmVIXLJNIMacroLabel());
 }
@@ -17,6 +17,8 @@
 #include "jni_macro_assembler_arm64.h"
 
 #include "entrypoints/quick/quick_entrypoints.h"
+#include "indirect_reference_table.h"
+#include "jni/jni_env_ext.h"
 #include "lock_word.h"
 #include "managed_register_arm64.h"
 #include "offsets.h"
@@ -974,6 +976,40 @@ void Arm64JNIMacroAssembler::DeliverPendingException() {
   ___ Brk();
 }
 
+void Arm64JNIMacroAssembler::DecodeJNITransitionOrLocalReference(ManagedRegister m_reg,
+                                                                 ManagedRegister m_jni_env,
+                                                                 ManagedRegister m_scratch,
+                                                                 JNIMacroLabel* slow_path,
+                                                                 JNIMacroLabel* resume) {
+  Arm64ManagedRegister arm64_reg = m_reg.AsArm64();
+  Register reg = reg_x(arm64_reg.IsXRegister() ? arm64_reg.AsXRegister()
+                                               : arm64_reg.AsOverlappingXRegister());
+  Register jni_env = reg_x(m_jni_env.AsArm64().AsXRegister());
+  Register scratch = reg_x(m_scratch.AsArm64().AsXRegister());
+  vixl::aarch64::Label* slow_path_label = Arm64JNIMacroLabel::Cast(slow_path)->AsArm64();
+  vixl::aarch64::Label* resume_label = Arm64JNIMacroLabel::Cast(resume)->AsArm64();
+  vixl::aarch64::Label local;
+  ___ Cbz(reg, resume_label);
+  ___ Ldrb(scratch.W(),
+          MEM_OP(jni_env, JNIEnvExt::CheckJniOffset(kArm64PointerSize).Int32Value()));
+  ___ Cbnz(scratch.W(), slow_path_label);
+  constexpr uintptr_t kGlobalOrWeakGlobalMask = IndirectReferenceTable::GetGlobalOrWeakGlobalMask();
+  constexpr uintptr_t kLocalMask = IndirectReferenceTable::GetLocalMask();
+  static_assert(IsPowerOfTwo(kGlobalOrWeakGlobalMask));
+  static_assert(IsPowerOfTwo(kLocalMask));
+  ___ Tbnz(reg, WhichPowerOf2(kGlobalOrWeakGlobalMask), slow_path_label);
+  ___ Tbnz(reg, WhichPowerOf2(kLocalMask), &local);
+  // JNI transition reference, pointing to a `StackReference<>`.
+  ___ Ldr(reg.W(), MEM_OP(reg));
+  ___ B(resume_label);
+  ___ Bind(&local);
+  // Local reference, load the `IrtEntry` reference from the current thread's local table.
+  ___ Ldr(scratch, MEM_OP(jni_env, JNIEnvExt::LocalsTableOffset(kArm64PointerSize).Int32Value()));
+  ___ Lsr(reg, reg, IndirectReferenceTable::GetIndexShift());
+  ___ Add(scratch, scratch, Operand(reg, LSL, WhichPowerOf2(sizeof(IrtEntry))));
+  ___ Ldr(reg.W(), MEM_OP(scratch, IrtEntry::ReferenceOffset().Int32Value()));
+}
+
 std::unique_ptr<JNIMacroLabel> Arm64JNIMacroAssembler::CreateLabel() {
   return std::unique_ptr<JNIMacroLabel>(new Arm64JNIMacroLabel());
 }
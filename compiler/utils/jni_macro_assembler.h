@@ -272,6 +272,16 @@ class JNIMacroAssembler : public DeletableArenaObject<kArenaAllocAssembler> {
   // Deliver pending exception.
   virtual void DeliverPendingException() = 0;
 
+  // Decode a JNI transition or local reference `jobject` held in `reg` in place, using the
+  // `jni_env_reg` (preserved) and `scratch_reg` (clobbered). Go to `resume` for null and to
+  // `slow_path` for (weak) global references or when CheckJNI is enabled. Otherwise fall through
+  // with the decoded reference in `reg`; the caller binds `resume` right after this code.
+  virtual void DecodeJNITransitionOrLocalReference(ManagedRegister reg,
+                                                   ManagedRegister jni_env_reg,
+                                                   ManagedRegister scratch_reg,
+                                                   JNIMacroLabel* slow_path,
+                                                   JNIMacroLabel* resume) = 0;
+
   // Create a new label that can be used with Jump/Bind calls.
   virtual std::unique_ptr<JNIMacroLabel> CreateLabel() = 0;
   // Emit an unconditional jump to the label.
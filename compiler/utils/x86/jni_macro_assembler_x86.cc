@@ -18,6 +18,8 @@
 
 #include "base/casts.h"
 #include "entrypoints/quick/quick_entrypoints.h"
+#include "indirect_reference_table.h"
+#include "jni/jni_env_ext.h"
 #include "lock_word.h"
 #include "thread.h"
 #include "utils/assembler.h"
@@ -682,6 +684,36 @@ void X86JNIMacroAssembler::DeliverPendingException() {
   __ int3();
 }
 
+void X86JNIMacroAssembler::DecodeJNITransitionOrLocalReference(ManagedRegister mreg,
+                                                               ManagedRegister mjni_env,
+                                                               ManagedRegister mscratch,
+                                                               JNIMacroLabel* slow_path,
+                                                               JNIMacroLabel* resume) {
+  Register reg = mreg.AsX86().AsCpuRegister();
+  Register jni_env = mjni_env.AsX86().AsCpuRegister();
+  Register scratch = mscratch.AsX86().AsCpuRegister();
+  Label* slow_path_label = X86JNIMacroLabel::Cast(slow_path)->AsX86();
+  Label* resume_label = X86JNIMacroLabel::Cast(resume)->AsX86();
+  NearLabel local;
+  __ testl(reg, reg);
+  __ j(kZero, resume_label);
+  __ cmpb(Address(jni_env, JNIEnvExt::CheckJniOffset(kX86PointerSize).Int32Value()), Immediate(0));
+  __ j(kNotEqual, slow_path_label);
+  __ testl(reg, Immediate(IndirectReferenceTable::GetGlobalOrWeakGlobalMask()));
+  __ j(kNotZero, slow_path_label);
+  __ testl(reg, Immediate(IndirectReferenceTable::GetLocalMask()));
+  __ j(kNotZero, &local);
+  // JNI transition reference, pointing to a `StackReference<>`.
+  __ movl(reg, Address(reg, 0));
+  __ jmp(resume_label);
+  __ Bind(&local);
+  // Local reference, load the `IrtEntry` reference from the current thread's local table.
+  __ movl(scratch, Address(jni_env, JNIEnvExt::LocalsTableOffset(kX86PointerSize).Int32Value()));
+  __ shrl(reg, Immediate(IndirectReferenceTable::GetIndexShift()));
+  static_assert(sizeof(IrtEntry) == 8u);
+  __ movl(reg, Address(scratch, reg, TIMES_8, IrtEntry::ReferenceOffset().Int32Value()));
+}
+
 std::unique_ptr<JNIMacroLabel> X86JNIMacroAssembler::CreateLabel() {
   return std::unique_ptr<JNIMacroLabel>(new X86JNIMacroLabel());
 }
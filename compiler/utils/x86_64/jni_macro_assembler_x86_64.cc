@@ -19,6 +19,8 @@
 #include "base/casts.h"
 #include "base/memory_region.h"
 #include "entrypoints/quick/quick_entrypoints.h"
+#include "indirect_reference_table.h"
+#include "jni/jni_env_ext.h"
 #include "lock_word.h"
 #include "thread.h"
 
@@ -760,6 +762,38 @@ void X86_64JNIMacroAssembler::DeliverPendingException() {
   __ int3();
 }
 
+void X86_64JNIMacroAssembler::DecodeJNITransitionOrLocalReference(ManagedRegister mreg,
+                                                                  ManagedRegister mjni_env,
+                                                                  ManagedRegister mscratch,
+                                                                  JNIMacroLabel* slow_path,
+                                                                  JNIMacroLabel* resume) {
+  CpuRegister reg = mreg.AsX86_64().AsCpuRegister();
+  CpuRegister jni_env = mjni_env.AsX86_64().AsCpuRegister();
+  CpuRegister scratch = mscratch.AsX86_64().AsCpuRegister();
+  Label* slow_path_label = X86_64JNIMacroLabel::Cast(slow_path)->AsX86_64();
+  Label* resume_label = X86_64JNIMacroLabel::Cast(resume)->AsX86_64();
+  NearLabel local;
+  __ testq(reg, reg);
+  __ j(kZero, resume_label);
+  __ cmpb(Address(jni_env, JNIEnvExt::CheckJniOffset(kX86_64PointerSize).Int32Value()),
+          Immediate(0));
+  __ j(kNotEqual, slow_path_label);
+  __ testl(reg, Immediate(IndirectReferenceTable::GetGlobalOrWeakGlobalMask()));
+  __ j(kNotZero, slow_path_label);
+  __ testl(reg, Immediate(IndirectReferenceTable::GetLocalMask()));
+  __ j(kNotZero, &local);
+  // JNI transition reference, pointing to a `StackReference<>`.
+  __ movl(reg, Address(reg, 0));
+  __ jmp(resume_label);
+  __ Bind(&local);
+  // Local reference, load the `IrtEntry` reference from the current thread's local table.
+  __ movq(scratch,
+          Address(jni_env, JNIEnvExt::LocalsTableOffset(kX86_64PointerSize).Int32Value()));
+  __ shrq(reg, Immediate(IndirectReferenceTable::GetIndexShift()));
+  static_assert(sizeof(IrtEntry) == 8u);
+  __ movl(reg, Address(scratch, reg, TIMES_8, IrtEntry::ReferenceOffset().Int32Value()));
+}
+
 std::unique_ptr<JNIMacroLabel> X86_64JNIMacroAssembler::CreateLabel() {
   return std::unique_ptr<JNIMacroLabel>(new X86_64JNIMacroLabel());
 }
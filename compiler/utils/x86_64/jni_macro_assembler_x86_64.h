@@ -201,6 +201,13 @@ class X86_64JNIMacroAssembler final : public JNIMacroAssemblerFwd<X86_64Assemble
   // Deliver pending exception.
   void DeliverPendingException() override;
 
+  // Decode a JNI transition or local reference `jobject` held in `reg` in place.
+  void DecodeJNITransitionOrLocalReference(ManagedRegister reg,
+                                           ManagedRegister jni_env_reg,
+                                           ManagedRegister scratch_reg,
+                                           JNIMacroLabel* slow_path,
+                                           JNIMacroLabel* resume) override;
+
   // Create a new label that can be used with Jump/Bind calls.
   std::unique_ptr<JNIMacroLabel> CreateLabel() override;
   // Emit an unconditional jump to the label.
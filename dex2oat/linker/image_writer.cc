@@ -225,7 +225,7 @@ static ObjPtr<mirror::ObjectArray<mirror::Object>> AllocateBootImageLiveObjects(
 template <typename MirrorType>
 ObjPtr<MirrorType> ImageWriter::DecodeGlobalWithoutRB(JavaVMExt* vm, jobject obj) {
   DCHECK_EQ(IndirectReferenceTable::GetIndirectRefKind(obj), kGlobal);
-  return ObjPtr<MirrorType>::DownCast(vm->globals_.Get<kWithoutReadBarrier>(obj));
+  return ObjPtr<MirrorType>::DownCast(vm->GetGlobal<kWithoutReadBarrier>(obj));
 }
 
 template <typename MirrorType>
@@ -55,7 +55,17 @@
   METRIC(YoungGcThroughput, MetricsHistogram, 15, 0, 10'000)            \
   METRIC(FullGcThroughput, MetricsHistogram, 15, 0, 10'000)             \
   METRIC(YoungGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)     \
-  METRIC(FullGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)
+  METRIC(FullGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)      \
+  METRIC(JitMethodCompileFailureCount, MetricsCounter)                  \
+  METRIC(JitMethodCompileTime, MetricsHistogram, 15, 0, 1'000'000)      \
+  METRIC(JitMethodQueueWaitTime, MetricsHistogram, 15, 0, 1'000'000)    \
+  METRIC(JitMethodCodeSize, MetricsHistogram, 15, 0, 65'536)            \
+  METRIC(JitAdaptiveDeferredCount, MetricsCounter)                      \
+  METRIC(JitAdaptiveSkippedBaselineCount, MetricsCounter)               \
+  METRIC(MonitorContentionWaitTime, MetricsHistogram, 15, 0, 1'000'000) \
+  METRIC(MonitorSpinSuccessCount, MetricsCounter)                       \
+  METRIC(MonitorSpinFailureCount, MetricsCounter)                       \
+  METRIC(TimeToSafepoint, MetricsHistogram, 15, 0, 100'000)
 
 // A lot of the metrics implementation code is generated by passing one-off macros into ART_COUNTERS
 // and ART_HISTOGRAMS. This means metrics.h and metrics.cc are very #define-heavy, which can be
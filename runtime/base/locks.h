@@ -322,11 +322,9 @@ class Locks {
   // Guards soft references queue.
   static Mutex* reference_queue_soft_references_lock_ ACQUIRED_AFTER(reference_queue_phantom_references_lock_);
 
-  // Guard accesses to the JNI Global Reference table.
-  static ReaderWriterMutex* jni_globals_lock_ ACQUIRED_AFTER(reference_queue_soft_references_lock_);
-
-  // Guard accesses to the JNI Weak Global Reference table.
-  static Mutex* jni_weak_globals_lock_ ACQUIRED_AFTER(jni_globals_lock_);
+  // Guard accesses to the JNI Weak Global Reference table. The JNI Global Reference tables are
+  // guarded by locks owned by JavaVMExt at level kJniGlobalsLock.
+  static Mutex* jni_weak_globals_lock_ ACQUIRED_AFTER(reference_queue_soft_references_lock_);
 
   // Guard accesses to the JNI function table override.
   static Mutex* jni_function_table_lock_ ACQUIRED_AFTER(jni_weak_globals_lock_);
@@ -605,12 +605,10 @@ bool Mutex::ExclusiveTryLock(Thread* self) {
   return true;
 }
 
-bool Mutex::ExclusiveTryLockWithSpinning(Thread* self) {
-  // Spin a small number of times, since this affects our ability to respond to suspension
-  // requests. We spin repeatedly only if the mutex repeatedly becomes available and unavailable
+bool Mutex::ExclusiveTryLockWithSpinning(Thread* self, size_t max_spins) {
+  // We spin repeatedly only if the mutex repeatedly becomes available and unavailable
   // in rapid succession, and then we will typically not spin for the maximal period.
-  const int kMaxSpins = 5;
-  for (int i = 0; i < kMaxSpins; ++i) {
+  for (size_t i = 0; i < max_spins; ++i) {
     if (ExclusiveTryLock(self)) {
       return true;
     }
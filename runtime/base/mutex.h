@@ -187,7 +187,13 @@ class LOCKABLE Mutex : public BaseMutex {
   bool ExclusiveTryLock(Thread* self) TRY_ACQUIRE(true);
   bool TryLock(Thread* self) TRY_ACQUIRE(true) { return ExclusiveTryLock(self); }
   // Equivalent to ExclusiveTryLock, but retry for a short period before giving up.
-  bool ExclusiveTryLockWithSpinning(Thread* self) TRY_ACQUIRE(true);
+  // The period is made of up to `max_spins` brief waits for the mutex to be released.
+  bool ExclusiveTryLockWithSpinning(Thread* self, size_t max_spins = kDefaultMaxSpins)
+      TRY_ACQUIRE(true);
+
+  // Default number of brief waits for ExclusiveTryLockWithSpinning. Spin a small number
+  // of times, since this affects our ability to respond to suspension requests.
+  static constexpr size_t kDefaultMaxSpins = 5;
 
   // Release exclusive access.
   void ExclusiveUnlock(Thread* self) RELEASE();
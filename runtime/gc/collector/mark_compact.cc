@@ -3515,8 +3515,10 @@ void MarkCompact::MarkRootsCheckpoint(Thread* self, Runtime* runtime) {
   ThreadList* thread_list = runtime->GetThreadList();
   gc_barrier_.Init(self, 0);
   // Request the check point is run on all threads returning a count of the threads that must
-  // run through the barrier including self.
-  size_t barrier_count = thread_list->RunCheckpoint(&check_point);
+  // run through the barrier including self. Stacks of suspended threads are scanned in parallel
+  // by the heap's thread pool, if any.
+  size_t barrier_count =
+      thread_list->RunCheckpoint(&check_point, /* callback= */ nullptr, heap_->GetThreadPool());
   // Release locks then wait for all mutator threads to pass the barrier.
   // If there are no threads to wait which implys that all the checkpoint functions are finished,
   // then no need to release locks.
@@ -1189,9 +1189,17 @@ void MarkSweep::MarkRootsCheckpoint(Thread* self,
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   CheckpointMarkThreadRoots check_point(this, revoke_ros_alloc_thread_local_buffers_at_checkpoint);
   ThreadList* thread_list = Runtime::Current()->GetThreadList();
+  // Scan the stacks of suspended threads in parallel if we have worker threads.
+  ThreadPool* thread_pool = nullptr;
+  size_t thread_count = GetThreadCount(/* paused= */ false);
+  if (thread_count > 1) {
+    thread_pool = heap_->GetThreadPool();
+    thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  }
   // Request the check point is run on all threads returning a count of the threads that must
   // run through the barrier including self.
-  size_t barrier_count = thread_list->RunCheckpoint(&check_point);
+  size_t barrier_count =
+      thread_list->RunCheckpoint(&check_point, /* callback= */ nullptr, thread_pool);
   // Release locks then wait for all mutator threads to pass the barrier.
   // If there are no threads to wait which implys that all the checkpoint functions are finished,
   // then no need to release locks.
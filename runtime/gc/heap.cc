@@ -94,6 +94,7 @@
 #include "mirror/object_array-inl.h"
 #include "mirror/reference-inl.h"
 #include "mirror/var_handle.h"
+#include "monitor_pool.h"
 #include "nativehelper/scoped_local_ref.h"
 #include "obj_ptr-inl.h"
 #ifdef ART_TARGET_ANDROID
@@ -1591,6 +1592,9 @@ void Heap::Trim(Thread* self) {
     VLOG(heap) << "Deflating " << count << " monitors took "
         << PrettyDuration(NanoTime() - start_time);
   }
+  // Return the monitor pool chunks left empty by the deflation.
+  size_t released_chunks = MonitorPool::ReleaseEmptyChunks(self);
+  VLOG(heap) << "Released " << released_chunks << " monitor pool chunks";
   TrimIndirectReferenceTables(self);
   TrimSpaces(self);
   // Trim arenas that may have been used by JIT or verifier.
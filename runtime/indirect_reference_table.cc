@@ -125,6 +125,8 @@ IndirectReferenceTable::IndirectReferenceTable(size_t max_count,
       resizable_(resizable) {
   CHECK(error_msg != nullptr);
   CHECK_NE(desired_kind, kJniTransitionOrInvalid);
+  DCHECK_EQ(TableOffset(sizeof(void*)).Uint32Value(),
+            OFFSETOF_MEMBER(IndirectReferenceTable, table_));
 
   // Overflow and maximum check.
   CHECK_LE(max_count, kMaxTableSizeInBytes / sizeof(IrtEntry));
@@ -174,6 +174,10 @@ class IrtEntry {
 
   void SetReference(ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  static MemberOffset ReferenceOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(IrtEntry, reference_));
+  }
+
  private:
   uint32_t serial_;  // Incremented for each reuse; checked against reference.
   GcRoot<mirror::Object> reference_;
@@ -368,14 +372,57 @@ class IndirectReferenceTable {
     return Offset(0);
   }
 
+  static Offset TableOffset(size_t pointer_size) {
+    // Note: `table_` directly follows `segment_state_` and is pointer-aligned. This is checked
+    //       in the constructor.
+    return Offset(pointer_size);
+  }
+
   // Release pages past the end of the table that may have previously held references.
   void Trim() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Layout of indirect references, used by JNI stubs to decode JNI transition and local
+  // references without calling into the runtime.
+  static constexpr uintptr_t GetGlobalOrWeakGlobalMask() {
+    static_assert((kWeakGlobal & kGlobal) == kGlobal);
+    static_assert((kLocal & kGlobal) == 0);
+    static_assert((kJniTransitionOrInvalid & kGlobal) == 0);
+    return kGlobal;
+  }
+  static constexpr uintptr_t GetLocalMask() {
+    static_assert((kJniTransitionOrInvalid & kLocal) == 0);
+    return kLocal;
+  }
+  static constexpr size_t GetIndexShift() {
+    return kKindBits + kIRTSerialBits;
+  }
+
   // Determine what kind of indirect reference this is. Opposite of EncodeIndirectRefKind.
   ALWAYS_INLINE static inline IndirectRefKind GetIndirectRefKind(IndirectRef iref) {
     return DecodeIndirectRefKind(reinterpret_cast<uintptr_t>(iref));
   }
 
+  // A kind of references may be spread over several tables (shards) to reduce lock contention.
+  // The shard is then encoded in the low `shard_bits` bits of the index, so that the table of a
+  // reference is known without a search and each table checks its own serial numbers.
+  ALWAYS_INLINE static inline IndirectRef EncodeShard(IndirectRef iref,
+                                                      uint32_t shard,
+                                                      size_t shard_bits) {
+    DCHECK_LT(shard, 1u << shard_bits);
+    uintptr_t uref = reinterpret_cast<uintptr_t>(iref);
+    return reinterpret_cast<IndirectRef>(
+        EncodeIndex((DecodeIndex(uref) << shard_bits) | shard) | (uref & kSerialAndKindMask));
+  }
+  ALWAYS_INLINE static inline uint32_t DecodeShard(IndirectRef iref, size_t shard_bits) {
+    return ExtractIndex(iref) & ((1u << shard_bits) - 1u);
+  }
+  // Return the reference as known by the table of its shard. Opposite of EncodeShard.
+  ALWAYS_INLINE static inline IndirectRef RemoveShard(IndirectRef iref, size_t shard_bits) {
+    uintptr_t uref = reinterpret_cast<uintptr_t>(iref);
+    return reinterpret_cast<IndirectRef>(
+        EncodeIndex(DecodeIndex(uref) >> shard_bits) | (uref & kSerialAndKindMask));
+  }
+
   /* Reference validation for CheckJNI. */
   bool IsValidReference(IndirectRef, /*out*/std::string* error_msg) const
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -386,6 +433,8 @@ class IndirectReferenceTable {
   static constexpr size_t kKindBits = MinimumBitsToStore(
       static_cast<uint32_t>(IndirectRefKind::kLastKind));
   static constexpr uint32_t kKindMask = (1u << kKindBits) - 1;
+  static constexpr uintptr_t kSerialAndKindMask =
+      (static_cast<uintptr_t>(1u) << (kIRTSerialBits + kKindBits)) - 1u;
 
   static constexpr uintptr_t EncodeIndex(uint32_t table_index) {
     static_assert(sizeof(IndirectRef) == sizeof(uintptr_t), "Unexpected IndirectRef size");
@@ -444,12 +493,14 @@ class IndirectReferenceTable {
   /// semi-public - read/write by jni down calls.
   IRTSegmentState segment_state_;
 
-  // Mem map where we store the indirect refs. If it's invalid, and table_ is non-null, then
-  // table_ is valid, but was allocated via allocSmallIRT();
-  MemMap table_mem_map_;
   // bottom of the stack. Do not directly access the object references
   // in this as they are roots. Use Get() that has a read barrier.
+  // Read by JNI stubs to decode local references, see TableOffset().
   IrtEntry* table_;
+
+  // Mem map where we store the indirect refs. If it's invalid, and table_ is non-null, then
+  // table_ is valid, but was allocated via allocSmallIRT();
+  MemMap table_mem_map_;
   // bit mask, ORed into all irefs.
   const IndirectRefKind kind_;
 
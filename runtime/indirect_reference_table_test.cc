@@ -512,4 +512,34 @@ TEST_F(IndirectReferenceTableTest, Resize) {
   EXPECT_EQ(irt.Capacity(), kTableMax + 1);
 }
 
+TEST_F(IndirectReferenceTableTest, Shards) {
+  ScopedObjectAccess soa(Thread::Current());
+  static const size_t kTableMax = 20;
+  static const size_t kShardBits = 3;
+
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::Class> c = hs.NewHandle(
+      class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;"));
+  ASSERT_TRUE(c != nullptr);
+
+  std::string error_msg;
+  IndirectReferenceTable irt(kTableMax,
+                             kGlobal,
+                             IndirectReferenceTable::ResizableCapacity::kNo,
+                             &error_msg);
+  ASSERT_TRUE(irt.IsValid()) << error_msg;
+
+  const IRTSegmentState cookie = kIRTFirstSegment;
+  for (size_t i = 0; i != kTableMax; ++i) {
+    IndirectRef iref = irt.Add(cookie, c.Get(), &error_msg);
+    ASSERT_TRUE(iref != nullptr) << error_msg;
+    for (uint32_t shard = 0; shard != (1u << kShardBits); ++shard) {
+      IndirectRef sharded = IndirectReferenceTable::EncodeShard(iref, shard, kShardBits);
+      EXPECT_EQ(kGlobal, IndirectReferenceTable::GetIndirectRefKind(sharded));
+      EXPECT_EQ(shard, IndirectReferenceTable::DecodeShard(sharded, kShardBits));
+      EXPECT_EQ(iref, IndirectReferenceTable::RemoveShard(sharded, kShardBits));
+    }
+  }
+}
+
 }  // namespace art
@@ -30,7 +30,7 @@ inline bool InterpreterCache::Get(Thread* self, const void* key, /* out */ size_
     *value = entry.second;
     return true;
   }
-  return false;
+  return secondary_ != nullptr && GetFromSecondary(self, key, value);
 }
 
 inline void InterpreterCache::Set(Thread* self, const void* key, size_t value) {
@@ -40,7 +40,11 @@ inline void InterpreterCache::Set(Thread* self, const void* key, size_t value) {
   // they are disabled, this means the GC is processing the cache, and is
   // reading it concurrently.
   if (kUseReadBarrier && self->GetWeakRefAccessEnabled()) {
-    data_[IndexOf(key)] = Entry{key, value};
+    Entry& entry = data_[IndexOf(key)];
+    if (entry.first != nullptr && entry.first != key) {
+      Evict(entry);
+    }
+    entry = Entry{key, value};
   }
 }
 
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
-#include "interpreter_cache.h"
+#include "interpreter_cache-inl.h"
+
+#include <algorithm>
+
+#include "dex/dex_instruction.h"
 #include "thread-inl.h"
 
 namespace art {
@@ -23,6 +27,86 @@ void InterpreterCache::Clear(Thread* owning_thread) {
   DCHECK(owning_thread->GetInterpreterCache() == this);
   DCHECK(owning_thread == Thread::Current() || owning_thread->IsSuspended());
   data_.fill(Entry{});
+  if (secondary_ != nullptr) {
+    std::fill_n(secondary_.get(), GetSecondaryCapacity(), Entry{});
+    secondary_drops_ = 0u;
+  }
+}
+
+bool InterpreterCache::IsNativeEntry(const void* key) {
+  using Opcode = Instruction::Code;
+  Opcode opcode = reinterpret_cast<const Instruction*>(key)->Opcode();
+  // Keep in sync with the opcodes that `Thread::SweepInterpreterCache` does not visit.
+  return (Opcode::IGET <= opcode && opcode <= Opcode::SPUT_SHORT) ||
+         (Opcode::INVOKE_VIRTUAL <= opcode && opcode <= Opcode::INVOKE_INTERFACE_RANGE);
+}
+
+bool InterpreterCache::GetFromSecondary(Thread* self, const void* key, /* out */ size_t* value) {
+  DCHECK(secondary_ != nullptr);
+  size_t set = (reinterpret_cast<uintptr_t>(key) >> 2) & (secondary_sets_ - 1u);
+  Entry* ways = &secondary_[set * kSecondaryWays];
+  for (size_t i = 0; i != kSecondaryWays; ++i) {
+    if (ways[i].first == key) {
+      *value = ways[i].second;
+      // Remove the entry from the set and move it back to the direct-mapped array,
+      // which may in turn evict another entry to this set.
+      std::copy(ways + i + 1, ways + kSecondaryWays, ways + i);
+      ways[kSecondaryWays - 1] = Entry{};
+      Set(self, key, *value);
+      return true;
+    }
+  }
+  return false;
+}
+
+void InterpreterCache::Evict(const Entry& entry) {
+  if (!IsNativeEntry(entry.first)) {
+    // Entries holding references need to be visited by the GC, only keep them in `data_`.
+    return;
+  }
+  if (secondary_ == nullptr) {
+    secondary_sets_ = kMinSecondarySets;
+    secondary_.reset(new Entry[GetSecondaryCapacity()]());
+  }
+  if (InsertInSecondary(entry)) {
+    // Grow the cache of threads that keep evicting entries, e.g. because they
+    // interpret large methods.
+    ++secondary_drops_;
+    if (secondary_drops_ >= GetSecondaryCapacity() && secondary_sets_ < kMaxSecondarySets) {
+      GrowSecondary();
+    }
+  }
+}
+
+bool InterpreterCache::InsertInSecondary(const Entry& entry) {
+  size_t set = (reinterpret_cast<uintptr_t>(entry.first) >> 2) & (secondary_sets_ - 1u);
+  Entry* ways = &secondary_[set * kSecondaryWays];
+  // Entries are kept at the start of the set, from the most to the least recently
+  // used. Replace a stale entry for the same key, or else the first free or the
+  // least recently used one.
+  Entry* end = std::find_if(ways, ways + kSecondaryWays - 1, [&](const Entry& other) {
+    return other.first == entry.first || other.first == nullptr;
+  });
+  bool dropped = end->first != nullptr && end->first != entry.first;
+  std::copy_backward(ways, end, end + 1);
+  ways[0] = entry;
+  return dropped;
+}
+
+void InterpreterCache::GrowSecondary() {
+  std::unique_ptr<Entry[]> old_secondary = std::move(secondary_);
+  size_t old_capacity = GetSecondaryCapacity();
+  secondary_sets_ *= 2u;
+  secondary_.reset(new Entry[GetSecondaryCapacity()]());
+  secondary_drops_ = 0u;
+  // Reinsert from the least recently used ways, to preserve the order within sets.
+  for (size_t way = kSecondaryWays; way != 0u; --way) {
+    for (size_t i = way - 1u; i < old_capacity; i += kSecondaryWays) {
+      if (old_secondary[i].first != nullptr) {
+        InsertInSecondary(old_secondary[i]);
+      }
+    }
+  }
 }
 
 }  // namespace art
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
 
 #include "base/bit_utils.h"
 #include "base/macros.h"
@@ -42,6 +43,14 @@ class Thread;
 // We ensure consistency of the cache by clearing it
 // whenever any dex file is unloaded.
 //
+// The direct-mapped array is the only part of the cache that the assembly
+// interpreter looks up. Field and method entries evicted from it are kept in a
+// set-associative secondary cache, which is looked up on the slow path before
+// resolving again. The secondary cache is allocated on first eviction and grows
+// while it keeps evicting, so that threads interpreting large methods get a bigger
+// cache. It only holds native pointers and offsets, so the GC never needs to visit
+// it and its entries survive collections.
+//
 // Aligned to 16-bytes to make it easier to get the address of the cache
 // from assembly (it ensures that the offset is valid immediate value).
 class ALIGNED(16) InterpreterCache {
@@ -53,6 +62,12 @@ class ALIGNED(16) InterpreterCache {
   // Value of 256 has around 75% cache hit rate.
   static constexpr size_t kSize = 256;
 
+  // Number of entries per set of the secondary cache.
+  static constexpr size_t kSecondaryWays = 4;
+  // Initial and maximum number of sets of the secondary cache.
+  static constexpr size_t kMinSecondarySets = 32;
+  static constexpr size_t kMaxSecondarySets = 512;
+
   InterpreterCache() {
     // We can not use the Clear() method since the constructor will not
     // be called from the owning thread.
@@ -70,6 +85,10 @@ class ALIGNED(16) InterpreterCache {
     return data_;
   }
 
+  size_t GetSecondaryCapacity() const {
+    return secondary_sets_ * kSecondaryWays;
+  }
+
  private:
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
     static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
@@ -78,7 +97,29 @@ class ALIGNED(16) InterpreterCache {
     return index;
   }
 
+  // Whether the value cached for `key` holds no reference to a heap object, and
+  // can therefore be kept in the secondary cache.
+  static bool IsNativeEntry(const void* key);
+
+  // Look up `key` in the secondary cache and, if found, move it back to `data_`.
+  bool GetFromSecondary(Thread* self, const void* key, /* out */ size_t* value);
+
+  // Move `entry`, which is about to be overwritten in `data_`, to the secondary cache.
+  void Evict(const Entry& entry);
+
+  // Insert `entry` as the most recently used entry of its set in `secondary_`.
+  // Return whether another entry had to be dropped.
+  bool InsertInSecondary(const Entry& entry);
+
+  void GrowSecondary();
+
+  // Must be the first field, the assembly interpreter indexes it from the cache address.
   std::array<Entry, kSize> data_;
+
+  std::unique_ptr<Entry[]> secondary_;
+  size_t secondary_sets_ = 0u;
+  // Entries dropped from the secondary cache since it was last resized.
+  size_t secondary_drops_ = 0u;
 };
 
 }  // namespace art
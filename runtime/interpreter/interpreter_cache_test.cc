@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter_cache-inl.h"
+
+#include <vector>
+
+#include "common_runtime_test.h"
+#include "dex/dex_instruction.h"
+#include "thread-current-inl.h"
+
+namespace art {
+
+class InterpreterCacheTest : public CommonRuntimeTest {
+ protected:
+  // Distance in code units between keys that map to the same entry of the
+  // direct-mapped array.
+  static constexpr size_t kStride = InterpreterCache::kSize * 4u / sizeof(uint16_t);
+
+  // Create `count` instructions with the given opcode that all map to the same
+  // entry of the direct-mapped array, and to the same set of the secondary cache.
+  void MakeKeys(Instruction::Code opcode, size_t count) {
+    code_.assign(count * kStride, 0u);
+    for (size_t i = 0; i != count; ++i) {
+      code_[i * kStride] = opcode;
+    }
+  }
+
+  const void* Key(size_t i) const {
+    return &code_[i * kStride];
+  }
+
+  std::vector<uint16_t> code_;
+};
+
+TEST_F(InterpreterCacheTest, EvictedFieldEntriesAreKept) {
+  TEST_DISABLED_WITHOUT_BAKER_READ_BARRIERS();
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  MakeKeys(Instruction::IGET, InterpreterCache::kSecondaryWays + 1u);
+  for (size_t i = 0; i != InterpreterCache::kSecondaryWays + 1u; ++i) {
+    cache->Set(self, Key(i), i + 42u);
+  }
+  for (size_t i = 0; i != InterpreterCache::kSecondaryWays + 1u; ++i) {
+    size_t value = 0u;
+    ASSERT_TRUE(cache->Get(self, Key(i), &value));
+    EXPECT_EQ(i + 42u, value);
+  }
+
+  cache->Clear(self);
+  size_t value = 0u;
+  EXPECT_FALSE(cache->Get(self, Key(0), &value));
+}
+
+TEST_F(InterpreterCacheTest, EvictedReferenceEntriesAreDropped) {
+  TEST_DISABLED_WITHOUT_BAKER_READ_BARRIERS();
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  MakeKeys(Instruction::IGET, 2u);
+  code_[0] = Instruction::CONST_STRING;
+  cache->Set(self, Key(0), 42u);
+  cache->Set(self, Key(1), 43u);
+  size_t value = 0u;
+  EXPECT_FALSE(cache->Get(self, Key(0), &value));
+  EXPECT_TRUE(cache->Get(self, Key(1), &value));
+  EXPECT_EQ(43u, value);
+  cache->Clear(self);
+}
+
+TEST_F(InterpreterCacheTest, SecondaryCacheGrows) {
+  TEST_DISABLED_WITHOUT_BAKER_READ_BARRIERS();
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  size_t initial_capacity = InterpreterCache::kMinSecondarySets * InterpreterCache::kSecondaryWays;
+  size_t count = 2u * initial_capacity;
+  MakeKeys(Instruction::INVOKE_STATIC, count);
+  for (size_t i = 0; i != count; ++i) {
+    cache->Set(self, Key(i), i);
+  }
+  EXPECT_GT(cache->GetSecondaryCapacity(), initial_capacity);
+
+  // The most recently used entries are still there after resizing.
+  size_t value = 0u;
+  ASSERT_TRUE(cache->Get(self, Key(count - 2u), &value));
+  EXPECT_EQ(count - 2u, value);
+  cache->Clear(self);
+}
+
+}  // namespace art
@@ -99,6 +99,13 @@ inline void UpdateCache(Thread* self, uint16_t* dex_pc_ptr, T* value) {
   UpdateCache(self, dex_pc_ptr, reinterpret_cast<size_t>(value));
 }
 
+// Nterp only looks up the direct-mapped part of the cache inline. Before resolving
+// again, check whether the entry was evicted to the secondary cache.
+inline bool GetEvictedCacheEntry(Thread* self, uint16_t* dex_pc_ptr, /* out */ size_t* value) {
+  DCHECK(kUseReadBarrier) << "Nterp only works with read barriers";
+  return self->GetInterpreterCache()->Get(self, dex_pc_ptr, value);
+}
+
 #ifdef __arm__
 
 extern "C" void NterpStoreArm32Fprs(const char* shorty,
@@ -248,6 +255,10 @@ FLATTEN
 extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (GetEvictedCacheEntry(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   InvokeType invoke_type = kStatic;
   uint16_t method_index = 0;
@@ -429,6 +440,10 @@ extern "C" size_t NterpGetStaticField(Thread* self,
                                       size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_field;
+  if (GetEvictedCacheEntry(self, dex_pc_ptr, &cached_field)) {
+    return cached_field;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegB_21c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -472,6 +487,10 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
                                                 size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_offset;
+  if (GetEvictedCacheEntry(self, dex_pc_ptr, &cached_offset)) {
+    return dchecked_integral_cast<uint32_t>(cached_offset);
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegC_22c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
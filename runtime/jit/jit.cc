@@ -17,6 +17,11 @@
 #include "jit.h"
 
 #include <dlfcn.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <set>
+#include <sstream>
 
 #include "art_method-inl.h"
 #include "base/enums.h"
@@ -24,8 +29,11 @@
 #include "base/logging.h"  // For VLOG.
 #include "base/memfd.h"
 #include "base/memory_tool.h"
+#include "base/os.h"
 #include "base/runtime_debug.h"
 #include "base/scoped_flock.h"
+#include "base/time_utils.h"
+#include "base/unix_file/fd_file.h"
 #include "base/utils.h"
 #include "class_root-inl.h"
 #include "compilation_kind.h"
@@ -103,6 +111,15 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITZygotePoolThreadPthreadPriority);
+  jit_options->use_compile_event_log_ = options.Exists(RuntimeArgumentMap::JITCompileEventLog);
+  if (options.Exists(RuntimeArgumentMap::JITCompileEventTraceFile)) {
+    jit_options->compile_event_trace_file_ =
+        *options.Get(RuntimeArgumentMap::JITCompileEventTraceFile);
+  }
+  jit_options->use_adaptive_thresholds_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITAdaptiveThresholds);
+  jit_options->adaptive_max_workers_ =
+      std::max(options.GetOrDefault(RuntimeArgumentMap::JITAdaptiveMaxWorkers), 1u);
 
   // Set default optimize threshold to aid with checking defaults.
   jit_options->optimize_threshold_ =
@@ -170,6 +187,26 @@ void Jit::DumpInfo(std::ostream& os) {
 void Jit::DumpForSigQuit(std::ostream& os) {
   DumpInfo(os);
   ProfileSaver::DumpInstanceInfo(os);
+  if (event_log_ != nullptr) {
+    os << "JIT compile events (" << event_log_->GetNumberOfRecordedEvents() << " recorded):\n";
+    event_log_->DumpJson(os);
+  }
+}
+
+void Jit::WriteCompileEventTrace() {
+  const std::string& filename = options_->GetCompileEventTraceFile();
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(filename.c_str()));
+  if (file == nullptr) {
+    PLOG(WARNING) << "Could not open " << filename << " for writing JIT compile events";
+    return;
+  }
+  std::ostringstream oss;
+  event_log_->DumpTrace(oss);
+  std::string trace = oss.str();
+  if (!file->WriteFully(trace.c_str(), trace.length()) || file->FlushClose() != 0) {
+    PLOG(WARNING) << "Could not write JIT compile events to " << filename;
+    file->Erase();
+  }
 }
 
 void Jit::AddTimingLogger(const TimingLogger& logger) {
@@ -185,7 +222,24 @@ Jit::Jit(JitCodeCache* code_cache, JitOptions* options)
       lock_("JIT memory use lock"),
       zygote_mapping_methods_(),
       fd_methods_(-1),
-      fd_methods_size_(0) {}
+      fd_methods_size_(0),
+      last_load_sample_ns_(0u),
+      last_load_update_ns_(0u),
+      total_compile_cpu_ns_(0u),
+      last_sample_compile_cpu_ns_(0u),
+      num_cpus_(1u) {
+  if (options->UseCompileEventLog()) {
+    event_log_.reset(new JitEventLog());
+  }
+  if (options->UseAdaptiveThresholds()) {
+    load_controller_.reset(new JitLoadController(options->GetAdaptiveMaxWorkers()));
+    last_load_sample_ns_.store(NanoTime(), std::memory_order_relaxed);
+    last_load_update_ns_.store(last_load_sample_ns_.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_cpus_ = (num_cpus > 0) ? static_cast<size_t>(num_cpus) : 1u;
+  }
+}
 
 Jit* Jit::Create(JitCodeCache* code_cache, JitOptions* options) {
   if (jit_load_ == nullptr) {
@@ -259,12 +313,109 @@ bool Jit::LoadCompilerLibrary(std::string* error_msg) {
   return true;
 }
 
+// Find the code that was just committed for `method`. Return null if it cannot be found,
+// for example because the entrypoint was not updated as the class is not initialized yet.
+static const OatQuickMethodHeader* FindCompiledCode(JitCodeCache* code_cache,
+                                                    ArtMethod* method,
+                                                    CompilationKind compilation_kind)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (compilation_kind == CompilationKind::kOsr) {
+    return code_cache->LookupOsrMethodHeader(method);
+  }
+  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+  if (!code_cache->ContainsPc(entry_point)) {
+    return nullptr;
+  }
+  return OatQuickMethodHeader::FromEntryPoint(entry_point);
+}
+
+static uint32_t CountInlinedMethods(const OatQuickMethodHeader* header) {
+  if (!header->IsOptimized()) {
+    return 0u;
+  }
+  CodeInfo code_info = CodeInfo::DecodeInlineInfoOnly(header);
+  if (!code_info.HasInlineInfo()) {
+    return 0u;
+  }
+  std::set<uint64_t> inlined_methods;
+  for (StackMap stack_map : code_info.GetStackMaps()) {
+    for (InlineInfo inline_info : code_info.GetInlineInfosOf(stack_map)) {
+      inlined_methods.insert(inline_info.EncodesArtMethod()
+          ? reinterpret_cast<uintptr_t>(inline_info.GetArtMethod())
+          : code_info.GetMethodIndexOf(inline_info));
+    }
+  }
+  return dchecked_integral_cast<uint32_t>(inlined_methods.size());
+}
+
 bool Jit::CompileMethod(ArtMethod* method,
                         Thread* self,
                         CompilationKind compilation_kind,
                         bool prejit) {
+  return CompileMethodInternal(method, self, compilation_kind, prejit, /* queue_wait_ns= */ 0u);
+}
+
+bool Jit::CompileMethodInternal(ArtMethod* method,
+                                Thread* self,
+                                CompilationKind compilation_kind,
+                                bool prejit,
+                                uint64_t queue_wait_ns) {
+  uint64_t start_ns = NanoTime();
+  uint64_t start_cpu_ns = ThreadCpuNanoTime();
+  JitCompileResult result = DoCompileMethod(method, self, &compilation_kind, prejit);
+  uint64_t compile_ns = NanoTime() - start_ns;
+  uint64_t compile_cpu_ns = ThreadCpuNanoTime() - start_cpu_ns;
+  if (load_controller_ != nullptr) {
+    total_compile_cpu_ns_.fetch_add(compile_cpu_ns, std::memory_order_relaxed);
+  }
+
+  // Looking up the code takes the code cache lock for OSR and counting the inlined methods
+  // decodes the stack maps, so only do it when the event log needs them.
+  uint32_t code_size = 0u;
+  uint32_t inlined_methods = 0u;
+  if (result == JitCompileResult::kSuccess && event_log_ != nullptr) {
+    const OatQuickMethodHeader* header = FindCompiledCode(
+        code_cache_, method->GetInterfaceMethodIfProxy(kRuntimePointerSize), compilation_kind);
+    if (header != nullptr) {
+      code_size = header->GetCodeSize();
+      inlined_methods = CountInlinedMethods(header);
+    }
+  }
+
+  if (result == JitCompileResult::kSuccess || result == JitCompileResult::kCompilerFailed) {
+    metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+    metrics->JitMethodCompileTime()->Add(static_cast<int64_t>(NsToUs(compile_ns)));
+    metrics->JitMethodQueueWaitTime()->Add(static_cast<int64_t>(NsToUs(queue_wait_ns)));
+    // The code size is recorded by the code cache when committing the code.
+    if (result == JitCompileResult::kCompilerFailed) {
+      metrics->JitMethodCompileFailureCount()->AddOne();
+    }
+  }
+
+  if (event_log_ != nullptr) {
+    JitCompileEvent event;
+    snprintf(event.method_name, sizeof(event.method_name), "%s", method->PrettyMethod().c_str());
+    event.kind = compilation_kind;
+    event.result = result;
+    event.tid = static_cast<uint32_t>(self->GetTid());
+    event.code_size = code_size;
+    event.inlined_methods = inlined_methods;
+    event.start_ns = start_ns;
+    event.queue_wait_ns = queue_wait_ns;
+    event.compile_ns = compile_ns;
+    event.compile_cpu_ns = compile_cpu_ns;
+    event_log_->Record(event);
+  }
+  return result == JitCompileResult::kSuccess;
+}
+
+JitCompileResult Jit::DoCompileMethod(ArtMethod* method,
+                                      Thread* self,
+                                      /*inout*/ CompilationKind* compilation_kind_ptr,
+                                      bool prejit) {
   DCHECK(Runtime::Current()->UseJitCompilation());
   DCHECK(!method->IsRuntimeMethod());
+  CompilationKind& compilation_kind = *compilation_kind_ptr;
 
   // If the baseline flag was explicitly passed in the compiler options, change the compilation kind
   // from optimized to baseline.
@@ -285,7 +436,7 @@ bool Jit::CompileMethod(ArtMethod* method,
     VLOG(jit) << "JIT not compiling " << method->PrettyMethod()
               << " due to not being safe to jit according to runtime-callbacks. For example, there"
               << " could be breakpoints in this method.";
-    return false;
+    return JitCompileResult::kMethodBeingInspected;
   }
 
   if (!method->IsCompilable()) {
@@ -294,14 +445,14 @@ bool Jit::CompileMethod(ArtMethod* method,
     VLOG(jit) << "JIT not compiling " << method->PrettyMethod() << " due to method being made "
               << "obsolete while waiting for JIT task to run. This probably happened due to "
               << "concurrent structural class redefinition.";
-    return false;
+    return JitCompileResult::kNotCompilable;
   }
 
   // Don't compile the method if we are supposed to be deoptimized.
   instrumentation::Instrumentation* instrumentation = Runtime::Current()->GetInstrumentation();
   if (instrumentation->AreAllMethodsDeoptimized() || instrumentation->IsDeoptimized(method)) {
     VLOG(jit) << "JIT not compiling " << method->PrettyMethod() << " due to deoptimization";
-    return false;
+    return JitCompileResult::kDeoptimized;
   }
 
   JitMemoryRegion* region = GetCodeCache()->GetCurrentRegion();
@@ -309,14 +460,14 @@ bool Jit::CompileMethod(ArtMethod* method,
     VLOG(jit) << "JIT not osr compiling "
               << method->PrettyMethod()
               << " due to using shared region";
-    return false;
+    return JitCompileResult::kOsrInSharedRegion;
   }
 
   // If we get a request to compile a proxy method, we pass the actual Java method
   // of that proxy method, as the compiler does not expect a proxy method.
   ArtMethod* method_to_compile = method->GetInterfaceMethodIfProxy(kRuntimePointerSize);
   if (!code_cache_->NotifyCompilationOf(method_to_compile, self, compilation_kind, prejit)) {
-    return false;
+    return JitCompileResult::kNotNeeded;
   }
 
   VLOG(jit) << "Compiling method "
@@ -338,7 +489,7 @@ bool Jit::CompileMethod(ArtMethod* method,
                  << exception->Dump();
     }
   }
-  return success;
+  return success ? JitCompileResult::kSuccess : JitCompileResult::kCompilerFailed;
 }
 
 void Jit::WaitForWorkersToBeCreated() {
@@ -403,6 +554,9 @@ Jit::~Jit() {
     Runtime::Current()->DumpDeoptimizations(LOG_STREAM(INFO));
   }
   DeleteThreadPool();
+  if (!options_->GetCompileEventTraceFile().empty()) {
+    WriteCompileEventTrace();
+  }
   if (jit_compiler_ != nullptr) {
     delete jit_compiler_;
     jit_compiler_ = nullptr;
@@ -756,7 +910,11 @@ class JitCompileTask final : public Task {
   };
 
   JitCompileTask(ArtMethod* method, TaskKind task_kind, CompilationKind compilation_kind)
-      : method_(method), kind_(task_kind), compilation_kind_(compilation_kind), klass_(nullptr) {
+      : method_(method),
+        kind_(task_kind),
+        compilation_kind_(compilation_kind),
+        klass_(nullptr),
+        enqueue_time_ns_(NanoTime()) {
     ScopedObjectAccess soa(Thread::Current());
     // For a non-bootclasspath class, add a global ref to the class to prevent class unloading
     // until compilation is done.
@@ -782,11 +940,12 @@ class JitCompileTask final : public Task {
       switch (kind_) {
         case TaskKind::kCompile:
         case TaskKind::kPreCompile: {
-          Runtime::Current()->GetJit()->CompileMethod(
+          Runtime::Current()->GetJit()->CompileMethodInternal(
               method_,
               self,
               compilation_kind_,
-              /* prejit= */ (kind_ == TaskKind::kPreCompile));
+              /* prejit= */ (kind_ == TaskKind::kPreCompile),
+              /* queue_wait_ns= */ NanoTime() - enqueue_time_ns_);
           break;
         }
       }
@@ -803,6 +962,7 @@ class JitCompileTask final : public Task {
   const TaskKind kind_;
   const CompilationKind compilation_kind_;
   jobject klass_;
+  const uint64_t enqueue_time_ns_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JitCompileTask);
 };
@@ -863,6 +1023,21 @@ class JitZygoteDoneCompilingTask final : public SelfDeletingTask {
   DISALLOW_COPY_AND_ASSIGN(JitZygoteDoneCompilingTask);
 };
 
+/**
+ * A JIT task to feed a new sample to the load controller.
+ */
+class JitLoadSampleTask final : public SelfDeletingTask {
+ public:
+  JitLoadSampleTask() {}
+
+  void Run(Thread* self) override {
+    Runtime::Current()->GetJit()->UpdateLoadController(self);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(JitLoadSampleTask);
+};
+
 /**
  * A JIT task to run Java verification of boot classpath classes that were not
  * verified at compile-time.
@@ -1172,7 +1347,12 @@ void Jit::CreateThreadPool() {
 
   // We need peers as we may report the JIT thread, e.g., in the debugger.
   constexpr bool kJitPoolNeedsPeers = true;
-  thread_pool_.reset(new ThreadPool("Jit thread pool", 1, kJitPoolNeedsPeers));
+  size_t num_threads = (load_controller_ != nullptr) ? load_controller_->GetMaxWorkers() : 1u;
+  thread_pool_.reset(new ThreadPool("Jit thread pool", num_threads, kJitPoolNeedsPeers));
+  if (num_threads > 1u) {
+    // Extra workers are only activated by the load controller when the system is idle.
+    thread_pool_->SetMaxActiveWorkers(load_controller_->GetActiveWorkers());
+  }
 
   Runtime* runtime = Runtime::Current();
   thread_pool_->SetPthreadPriority(
@@ -1639,6 +1819,10 @@ void Jit::PreZygoteFork() {
   if (thread_pool_ == nullptr) {
     return;
   }
+  if (load_controller_ != nullptr) {
+    // `CreateThreads` only recreates the active workers, make sure we get all of them back.
+    thread_pool_->SetMaxActiveWorkers(thread_pool_->GetThreadCount());
+  }
   thread_pool_->DeleteThreads();
 
   NativeDebugInfoPreFork();
@@ -1666,6 +1850,9 @@ void Jit::PostZygoteFork() {
     CHECK(code_cache_->GetZygoteMap()->IsCompilationNotified());
   }
   thread_pool_->CreateThreads();
+  if (load_controller_ != nullptr) {
+    ApplyLoadControllerWorkers();
+  }
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
@@ -1780,11 +1967,26 @@ void Jit::MaybeEnqueueCompilation(ArtMethod* method, Thread* self) {
     }
   }
 
-  if (!method->IsNative() && GetCodeCache()->CanAllocateProfilingInfo()) {
+  bool skip_baseline = false;
+  if (load_controller_ != nullptr) {
+    MaybeRequestLoadSample(self);
+    if (!load_controller_->ShouldEnqueue()) {
+      // The system is saturated: let the method get hot again before compiling it.
+      Runtime::Current()->GetMetrics()->JitAdaptiveDeferredCount()->AddOne();
+      return;
+    }
+    skip_baseline = load_controller_->ShouldCompileOptimizedDirectly();
+    ApplyLoadControllerWorkers();
+  }
+
+  if (!method->IsNative() && GetCodeCache()->CanAllocateProfilingInfo() && !skip_baseline) {
     thread_pool_->AddTask(
         self,
         new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, CompilationKind::kBaseline));
   } else {
+    if (skip_baseline && !method->IsNative()) {
+      Runtime::Current()->GetMetrics()->JitAdaptiveSkippedBaselineCount()->AddOne();
+    }
     thread_pool_->AddTask(
         self,
         new JitCompileTask(method,
@@ -1793,5 +1995,62 @@ void Jit::MaybeEnqueueCompilation(ArtMethod* method, Thread* self) {
   }
 }
 
+void Jit::MaybeRequestLoadSample(Thread* self) {
+  DCHECK(load_controller_ != nullptr);
+  if (thread_pool_->GetThreadCount() == 0u) {
+    // The workers are deleted while the zygote forks, don't queue tasks for them.
+    return;
+  }
+  uint64_t now_ns = NanoTime();
+  uint64_t last_ns = last_load_sample_ns_.load(std::memory_order_relaxed);
+  if (now_ns - last_ns < JitLoadController::kSampleIntervalNs ||
+      !last_load_sample_ns_.compare_exchange_strong(last_ns, now_ns, std::memory_order_relaxed)) {
+    // Too early, or another thread is requesting the sample.
+    return;
+  }
+  // Reading the load average goes through procfs, keep it off the mutator threads.
+  thread_pool_->AddTask(self, new JitLoadSampleTask());
+}
+
+void Jit::UpdateLoadController(Thread* self) {
+  DCHECK(load_controller_ != nullptr);
+  uint64_t now_ns = NanoTime();
+  uint64_t last_ns = last_load_update_ns_.exchange(now_ns, std::memory_order_relaxed);
+  uint64_t total_compile_cpu_ns = total_compile_cpu_ns_.load(std::memory_order_relaxed);
+  double load_average = -1.0;
+  if (getloadavg(&load_average, 1) != 1) {
+    load_average = -1.0;
+  }
+  JitLoadController::Sample sample;
+  sample.queue_length = thread_pool_->GetTaskCount(self);
+  sample.compile_cpu_ns = total_compile_cpu_ns -
+      last_sample_compile_cpu_ns_.exchange(total_compile_cpu_ns, std::memory_order_relaxed);
+  sample.wall_ns = now_ns - last_ns;
+  sample.load_average = load_average;
+  sample.num_cpus = num_cpus_;
+
+  int32_t old_level = load_controller_->GetLevel();
+  load_controller_->Update(sample);
+  int32_t new_level = load_controller_->GetLevel();
+  if (old_level != new_level) {
+    VLOG(jit) << "JIT load level " << old_level << " -> " << new_level
+              << " (load average " << load_average << ", " << num_cpus_ << " cpus, "
+              << sample.queue_length << " queued tasks)";
+  }
+}
+
+void Jit::ApplyLoadControllerWorkers() {
+  DCHECK(load_controller_ != nullptr);
+  // Only mutator threads change the number of active workers, so this cannot race with
+  // `PreZygoteFork` and `PostZygoteFork`, which run when the forking thread is the only one.
+  size_t thread_count = thread_pool_->GetThreadCount();
+  if (thread_count == 0u) {
+    // The workers are deleted while the zygote forks. `PostZygoteFork` applies the
+    // worker count when it creates them again.
+    return;
+  }
+  thread_pool_->SetMaxActiveWorkers(std::min(load_controller_->GetActiveWorkers(), thread_count));
+}
+
 }  // namespace jit
 }  // namespace art
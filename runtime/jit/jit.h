@@ -29,6 +29,8 @@
 #include "offsets.h"
 #include "interpreter/mterp/nterp.h"
 #include "jit/debugger_interface.h"
+#include "jit/jit_event_log.h"
+#include "jit/jit_load_controller.h"
 #include "jit/profile_saver_options.h"
 #include "obj_ptr.h"
 #include "thread_pool.h"
@@ -147,6 +149,22 @@ class JitOptions {
     return use_baseline_compiler_;
   }
 
+  bool UseCompileEventLog() const {
+    return use_compile_event_log_ || !compile_event_trace_file_.empty();
+  }
+
+  const std::string& GetCompileEventTraceFile() const {
+    return compile_event_trace_file_;
+  }
+
+  bool UseAdaptiveThresholds() const {
+    return use_adaptive_thresholds_;
+  }
+
+  size_t GetAdaptiveMaxWorkers() const {
+    return adaptive_max_workers_;
+  }
+
  private:
   // We add the sample in batches of size kJitSamplesBatchSize.
   // This method rounds the threshold so that it is multiple of the batch size.
@@ -162,6 +180,10 @@ class JitOptions {
   uint16_t priority_thread_weight_;
   uint16_t invoke_transition_weight_;
   bool dump_info_on_shutdown_;
+  bool use_compile_event_log_;
+  std::string compile_event_trace_file_;
+  bool use_adaptive_thresholds_;
+  size_t adaptive_max_workers_;
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
   ProfileSaverOptions profile_saver_options_;
@@ -177,6 +199,9 @@ class JitOptions {
         priority_thread_weight_(0),
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
+        use_compile_event_log_(false),
+        use_adaptive_thresholds_(false),
+        adaptive_max_workers_(1u),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
         zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
 
@@ -333,6 +358,12 @@ class Jit {
 
   void DumpForSigQuit(std::ostream& os) REQUIRES(!lock_);
 
+  // Return the log of recent compilations, or null if not enabled with
+  // -XX:JITCompileEventLog or -XX:JITCompileEventTraceFile.
+  const JitEventLog* GetEventLog() const {
+    return event_log_.get();
+  }
+
   static void NewTypeLoadedIfUsingJit(mirror::Class* type)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -441,9 +472,39 @@ class Jit {
   void MaybeEnqueueCompilation(ArtMethod* method, Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Feed a new sample to the load controller. Called on a JIT worker.
+  void UpdateLoadController(Thread* self);
+
  private:
   Jit(JitCodeCache* code_cache, JitOptions* options);
 
+  // Compile `method` and record the outcome in the metrics and the event log.
+  // `queue_wait_ns` is the time the request spent in the JIT thread pool queue.
+  bool CompileMethodInternal(ArtMethod* method,
+                             Thread* self,
+                             CompilationKind compilation_kind,
+                             bool prejit,
+                             uint64_t queue_wait_ns)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Do the actual compilation. `compilation_kind` is updated to the kind of
+  // compilation that was attempted.
+  JitCompileResult DoCompileMethod(ArtMethod* method,
+                                   Thread* self,
+                                   /*inout*/ CompilationKind* compilation_kind,
+                                   bool prejit)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Write the event log to the file given with -XX:JITCompileEventTraceFile.
+  void WriteCompileEventTrace();
+
+  // Queue a task to sample the system load if the sampling interval has elapsed.
+  void MaybeRequestLoadSample(Thread* self);
+
+  // Apply the worker count of the load controller to the thread pool. Only called
+  // from mutator threads.
+  void ApplyLoadControllerWorkers();
+
   // Whether we should not add hotness counts for the given method.
   bool IgnoreSamplesForMethod(ArtMethod* method)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -480,6 +541,15 @@ class Jit {
 
   // Performance monitoring.
   CumulativeLogger cumulative_timings_;
+  std::unique_ptr<JitEventLog> event_log_;
+
+  // Adaptive thresholds, enabled with -XX:JITAdaptiveThresholds.
+  std::unique_ptr<JitLoadController> load_controller_;
+  std::atomic<uint64_t> last_load_sample_ns_;
+  std::atomic<uint64_t> last_load_update_ns_;
+  std::atomic<uint64_t> total_compile_cpu_ns_;
+  std::atomic<uint64_t> last_sample_compile_cpu_ns_;
+  size_t num_cpus_;
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
@@ -507,6 +577,8 @@ class Jit {
   // between the zygote and apps.
   std::map<ArtMethod*, uint16_t> shared_method_counters_;
 
+  friend class JitCompileTask;
+
   DISALLOW_COPY_AND_ASSIGN(Jit);
 };
 
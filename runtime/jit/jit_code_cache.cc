@@ -791,6 +791,8 @@ bool JitCodeCache::Commit(Thread* self,
                                          method_header->GetCodeSize());
   }
 
+  Runtime::Current()->GetMetrics()->JitMethodCodeSize()->Add(
+      static_cast<int64_t>(method_header->GetCodeSize()));
   return true;
 }
 
@@ -1850,6 +1852,18 @@ void JitCodeCache::InvalidateCompiledCodeFor(ArtMethod* method,
   }
 }
 
+void JitCodeCache::AddDeoptimizationFeedback(ArtMethod* method,
+                                             DeoptimizationKind kind,
+                                             uint32_t dex_pc) {
+  Thread* self = Thread::Current();
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it != profiling_infos_.end()) {
+    it->second->AddDeoptimization(kind, dex_pc);
+  }
+}
+
 void JitCodeCache::Dump(std::ostream& os) {
   MutexLock mu(Thread::Current(), *Locks::jit_lock_);
   os << "Current JIT code cache size (used / resident): "
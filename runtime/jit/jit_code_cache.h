@@ -33,6 +33,7 @@
 #include "base/mutex.h"
 #include "base/safe_map.h"
 #include "compilation_kind.h"
+#include "deoptimization_kind.h"
 #include "jit_memory_region.h"
 #include "profiling_info.h"
 
@@ -339,6 +340,12 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record in the profiling info of `method` that its compiled code deoptimized,
+  // so that the compiler can avoid the failing speculation when recompiling it.
+  void AddDeoptimizationFeedback(ArtMethod* method, DeoptimizationKind kind, uint32_t dex_pc)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void Dump(std::ostream& os) REQUIRES(!Locks::jit_lock_);
 
   bool IsOsrCompiled(ArtMethod* method) REQUIRES(!Locks::jit_lock_);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_event_log.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <ostream>
+
+#include "base/time_utils.h"
+
+namespace art {
+namespace jit {
+
+std::ostream& operator<<(std::ostream& os, JitCompileResult rhs) {
+  switch (rhs) {
+    case JitCompileResult::kSuccess:
+      return os << "success";
+    case JitCompileResult::kMethodBeingInspected:
+      return os << "method-being-inspected";
+    case JitCompileResult::kNotCompilable:
+      return os << "not-compilable";
+    case JitCompileResult::kDeoptimized:
+      return os << "deoptimized";
+    case JitCompileResult::kOsrInSharedRegion:
+      return os << "osr-in-shared-region";
+    case JitCompileResult::kNotNeeded:
+      return os << "not-needed";
+    case JitCompileResult::kCompilerFailed:
+      return os << "compiler-failed";
+  }
+}
+
+static const char* GetCompilationKindName(CompilationKind kind) {
+  switch (kind) {
+    case CompilationKind::kOsr:
+      return "osr";
+    case CompilationKind::kBaseline:
+      return "baseline";
+    case CompilationKind::kOptimized:
+      return "optimized";
+  }
+}
+
+// Method names may contain characters that need escaping, e.g. in lambda names.
+static void DumpJsonString(std::ostream& os, const char* str) {
+  os << '"';
+  for (const char* c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      os << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      os << ' ';
+    } else {
+      os << *c;
+    }
+  }
+  os << '"';
+}
+
+JitEventLog::JitEventLog() : next_index_(0u), slots_(new Slot[kCapacity]()) {}
+
+void JitEventLog::Record(const JitCompileEvent& event) {
+  uint64_t index = next_index_.fetch_add(1u, std::memory_order_relaxed);
+  Slot& slot = slots_[index % kCapacity];
+  slot.sequence.store(2u * index + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(&slot.event, &event, sizeof(JitCompileEvent));
+  slot.sequence.store(2u * index + 2u, std::memory_order_release);
+}
+
+std::vector<JitCompileEvent> JitEventLog::Snapshot() const {
+  std::vector<JitCompileEvent> events;
+  uint64_t end = next_index_.load(std::memory_order_acquire);
+  uint64_t begin = (end > kCapacity) ? end - kCapacity : 0u;
+  events.reserve(end - begin);
+  for (uint64_t index = begin; index != end; ++index) {
+    const Slot& slot = slots_[index % kCapacity];
+    uint64_t expected_sequence = 2u * index + 2u;
+    if (slot.sequence.load(std::memory_order_acquire) != expected_sequence) {
+      // Still being written, or already overwritten by a newer event.
+      continue;
+    }
+    JitCompileEvent event;
+    memcpy(&event, &slot.event, sizeof(JitCompileEvent));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == expected_sequence) {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+void JitEventLog::DumpJson(std::ostream& os) const {
+  std::vector<JitCompileEvent> events = Snapshot();
+  os << "[";
+  const char* separator = "\n";
+  for (const JitCompileEvent& event : events) {
+    os << separator << "  {\"method\": ";
+    DumpJsonString(os, event.method_name);
+    os << ", \"kind\": \"" << GetCompilationKindName(event.kind) << "\""
+       << ", \"result\": \"" << event.result << "\""
+       << ", \"tid\": " << event.tid
+       << ", \"start_us\": " << NsToUs(event.start_ns)
+       << ", \"queue_wait_us\": " << NsToUs(event.queue_wait_ns)
+       << ", \"compile_us\": " << NsToUs(event.compile_ns)
+       << ", \"compile_cpu_us\": " << NsToUs(event.compile_cpu_ns)
+       << ", \"code_size\": " << event.code_size
+       << ", \"inlined_methods\": " << event.inlined_methods
+       << "}";
+    separator = ",\n";
+  }
+  os << "\n]\n";
+}
+
+void JitEventLog::DumpTrace(std::ostream& os) const {
+  std::vector<JitCompileEvent> events = Snapshot();
+  os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  const char* separator = "\n";
+  for (const JitCompileEvent& event : events) {
+    // Complete ("X") events take their timestamp and duration in microseconds.
+    os << separator << "  {\"ph\": \"X\", \"cat\": \"jit\", \"name\": ";
+    DumpJsonString(os, event.method_name);
+    os << ", \"pid\": " << getpid()
+       << ", \"tid\": " << event.tid
+       << ", \"ts\": " << NsToUs(event.start_ns)
+       << ", \"dur\": " << NsToUs(event.compile_ns)
+       << ", \"args\": {\"kind\": \"" << GetCompilationKindName(event.kind) << "\""
+       << ", \"result\": \"" << event.result << "\""
+       << ", \"queue_wait_us\": " << NsToUs(event.queue_wait_ns)
+       << ", \"compile_cpu_us\": " << NsToUs(event.compile_cpu_ns)
+       << ", \"code_size\": " << event.code_size
+       << ", \"inlined_methods\": " << event.inlined_methods
+       << "}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_EVENT_LOG_H_
+#define ART_RUNTIME_JIT_JIT_EVENT_LOG_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "compilation_kind.h"
+
+namespace art {
+namespace jit {
+
+// Outcome of a request to JIT compile a method.
+enum class JitCompileResult : uint8_t {
+  kSuccess,
+  kMethodBeingInspected,  // The method has breakpoints or is otherwise being inspected.
+  kNotCompilable,         // The method was made obsolete while waiting for compilation.
+  kDeoptimized,           // The method is required to run in the interpreter.
+  kOsrInSharedRegion,     // OSR code cannot be put in the shared (zygote) region.
+  kNotNeeded,             // Already compiled, or being compiled by another thread.
+  kCompilerFailed,        // The compiler bailed out or ran out of code cache space.
+};
+
+std::ostream& operator<<(std::ostream& os, JitCompileResult rhs);
+
+// Everything recorded about a single JIT compilation request.
+struct JitCompileEvent {
+  static constexpr size_t kMaxMethodNameLength = 120;
+
+  // Pretty name of the method, truncated to fit and always NUL-terminated.
+  char method_name[kMaxMethodNameLength];
+  CompilationKind kind;
+  JitCompileResult result;
+  uint32_t tid;
+  // Size of the generated code, or 0 if unknown or the compilation failed.
+  uint32_t code_size;
+  // Number of distinct methods inlined into the generated code.
+  uint32_t inlined_methods;
+  // NanoTime() at which the compilation started.
+  uint64_t start_ns;
+  // Time the request spent in the JIT thread pool queue; 0 for direct compilations.
+  uint64_t queue_wait_ns;
+  // Wall and thread CPU time spent handling the request.
+  uint64_t compile_ns;
+  uint64_t compile_cpu_ns;
+};
+
+// Ring buffer holding the most recent JitCompileEvents.
+//
+// Recording is lock-free so that compiler threads never contend with each other nor
+// with a dump in progress. Each slot carries a sequence number that a reader checks
+// before and after copying the event; events being overwritten during a dump are
+// skipped rather than reported torn.
+class JitEventLog {
+ public:
+  static constexpr size_t kCapacity = 512;
+
+  JitEventLog();
+
+  void Record(const JitCompileEvent& event);
+
+  // Return a copy of the events currently in the log, oldest first.
+  std::vector<JitCompileEvent> Snapshot() const;
+
+  // Total number of events recorded, including those that have been overwritten.
+  uint64_t GetNumberOfRecordedEvents() const {
+    return next_index_.load(std::memory_order_relaxed);
+  }
+
+  // Dump the events as a JSON array with one object per event.
+  void DumpJson(std::ostream& os) const;
+
+  // Dump the events in the JSON trace event format, which both Perfetto UI and
+  // chrome://tracing can load. Each compilation shows up as a slice on the track
+  // of the JIT thread that performed it.
+  void DumpTrace(std::ostream& os) const;
+
+ private:
+  struct Slot {
+    // 0 if never written; 2 * index + 1 while event `index` is being written;
+    // 2 * index + 2 once it is complete.
+    std::atomic<uint64_t> sequence;
+    JitCompileEvent event;
+  };
+
+  std::atomic<uint64_t> next_index_;
+  std::unique_ptr<Slot[]> slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitEventLog);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_EVENT_LOG_H_
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit_event_log.h"
+
+#include <stdio.h>
+
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace art {
+namespace jit {
+
+static JitCompileEvent MakeEvent(const char* name, uint32_t code_size) {
+  JitCompileEvent event = {};
+  snprintf(event.method_name, sizeof(event.method_name), "%s", name);
+  event.kind = CompilationKind::kOptimized;
+  event.result = JitCompileResult::kSuccess;
+  event.tid = 42u;
+  event.code_size = code_size;
+  event.start_ns = 1000u * code_size;
+  event.compile_ns = 2000u;
+  return event;
+}
+
+TEST(JitEventLogTest, Empty) {
+  JitEventLog log;
+  EXPECT_EQ(log.GetNumberOfRecordedEvents(), 0u);
+  EXPECT_TRUE(log.Snapshot().empty());
+}
+
+TEST(JitEventLogTest, RecordsInOrder) {
+  JitEventLog log;
+  log.Record(MakeEvent("void Foo.a()", 1u));
+  log.Record(MakeEvent("void Foo.b()", 2u));
+  std::vector<JitCompileEvent> events = log.Snapshot();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_STREQ(events[0].method_name, "void Foo.a()");
+  EXPECT_EQ(events[0].code_size, 1u);
+  EXPECT_STREQ(events[1].method_name, "void Foo.b()");
+  EXPECT_EQ(events[1].code_size, 2u);
+}
+
+TEST(JitEventLogTest, KeepsMostRecentEvents) {
+  JitEventLog log;
+  size_t total = JitEventLog::kCapacity + 10u;
+  for (size_t i = 0; i != total; ++i) {
+    log.Record(MakeEvent("void Foo.a()", static_cast<uint32_t>(i)));
+  }
+  EXPECT_EQ(log.GetNumberOfRecordedEvents(), total);
+  std::vector<JitCompileEvent> events = log.Snapshot();
+  ASSERT_EQ(events.size(), JitEventLog::kCapacity);
+  EXPECT_EQ(events.front().code_size, 10u);
+  EXPECT_EQ(events.back().code_size, total - 1u);
+}
+
+TEST(JitEventLogTest, DumpEscapesNames) {
+  JitEventLog log;
+  log.Record(MakeEvent("void Foo.\"quoted\"()", 4u));
+  std::ostringstream json;
+  log.DumpJson(json);
+  EXPECT_NE(json.str().find("\"method\": \"void Foo.\\\"quoted\\\"()\""), std::string::npos)
+      << json.str();
+  EXPECT_NE(json.str().find("\"result\": \"success\""), std::string::npos) << json.str();
+  std::ostringstream trace;
+  log.DumpTrace(trace);
+  EXPECT_NE(trace.str().find("\"ph\": \"X\""), std::string::npos) << trace.str();
+  EXPECT_NE(trace.str().find("\"dur\": 2"), std::string::npos) << trace.str();
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_load_controller.h"
+
+#include <algorithm>
+
+#include "android-base/logging.h"
+
+namespace art {
+namespace jit {
+
+JitLoadController::JitLoadController(size_t max_workers)
+    : max_workers_(max_workers), level_(0), active_workers_(1u), hot_events_(0u) {
+  DCHECK_GE(max_workers, 1u);
+}
+
+void JitLoadController::Update(const Sample& sample) {
+  if (sample.load_average < 0.0 || sample.wall_ns == 0u) {
+    // No usable data, keep the current decisions.
+    return;
+  }
+  double load_per_cpu = sample.load_average / std::max<size_t>(sample.num_cpus, 1u);
+  size_t active_workers = GetActiveWorkers();
+  double jit_utilization = static_cast<double>(sample.compile_cpu_ns) /
+      (static_cast<double>(sample.wall_ns) * active_workers);
+
+  int32_t level = GetLevel();
+  if (load_per_cpu >= kSaturatedLoadPerCpu) {
+    // Back off, faster if the JIT itself is a large part of the load.
+    level += (jit_utilization >= kBusyJitUtilization) ? 2 : 1;
+  } else if (load_per_cpu <= kIdleLoadPerCpu) {
+    --level;
+  } else if (level < 0) {
+    // Some load, but not saturated: return to the default behavior.
+    level = 0;
+  } else if (level > 0) {
+    --level;
+  }
+  level = std::clamp(level, kMinLevel, kMaxLevel);
+  level_.store(level, std::memory_order_relaxed);
+
+  // Only add workers when there is a backlog and the machine has spare CPUs for them.
+  size_t workers = (level < 0 && sample.queue_length > 1u) ? max_workers_ : 1u;
+  active_workers_.store(workers, std::memory_order_relaxed);
+}
+
+}  // namespace jit
+}  // namespace art
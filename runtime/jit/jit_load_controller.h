@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_LOAD_CONTROLLER_H_
+#define ART_RUNTIME_JIT_JIT_LOAD_CONTROLLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "base/macros.h"
+#include "base/time_utils.h"
+
+namespace art {
+namespace jit {
+
+// Adapts how eagerly the JIT compiles to the CPU headroom of the machine.
+//
+// The controller maintains a level, updated from periodic samples of the system
+// load, the JIT queue length and the CPU time spent compiling:
+// - A positive level means the machine is saturated. Only one in 2^level requests
+//   for a method that reached its hotness threshold is honored, which
+//   statistically scales the hotness thresholds by 2^level and leaves cycles to
+//   the application threads.
+// - A negative level means the machine is idle. Methods are then compiled
+//   optimized right away, skipping the baseline tier, and the JIT may use more
+//   than one worker to drain its queue.
+class JitLoadController {
+ public:
+  static constexpr uint64_t kSampleIntervalNs = MsToNs(500);
+  static constexpr int32_t kMinLevel = -1;
+  static constexpr int32_t kMaxLevel = 4;
+
+  // Load average per CPU above which we consider the machine saturated.
+  static constexpr double kSaturatedLoadPerCpu = 1.0;
+  // Load average per CPU below which we consider the machine idle.
+  static constexpr double kIdleLoadPerCpu = 0.5;
+  // Fraction of the JIT workers' time spent compiling above which the JIT is
+  // considered to be a significant contributor to the load.
+  static constexpr double kBusyJitUtilization = 0.5;
+
+  struct Sample {
+    // Number of tasks waiting in the JIT thread pool.
+    size_t queue_length;
+    // Thread CPU time spent compiling since the previous sample.
+    uint64_t compile_cpu_ns;
+    // Wall time since the previous sample.
+    uint64_t wall_ns;
+    // One minute system load average, or a negative value if unavailable.
+    double load_average;
+    size_t num_cpus;
+  };
+
+  explicit JitLoadController(size_t max_workers);
+
+  // Update the level and worker count from a new sample.
+  void Update(const Sample& sample);
+
+  int32_t GetLevel() const {
+    return level_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetActiveWorkers() const {
+    return active_workers_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetMaxWorkers() const {
+    return max_workers_;
+  }
+
+  // Return whether a method that just reached its hotness threshold should be
+  // enqueued for compilation.
+  bool ShouldEnqueue() {
+    int32_t level = GetLevel();
+    if (level <= 0) {
+      return true;
+    }
+    uint32_t mask = (1u << level) - 1u;
+    return (hot_events_.fetch_add(1u, std::memory_order_relaxed) & mask) == 0u;
+  }
+
+  // Return whether the baseline tier should be skipped.
+  bool ShouldCompileOptimizedDirectly() const {
+    return GetLevel() < 0;
+  }
+
+ private:
+  const size_t max_workers_;
+  std::atomic<int32_t> level_;
+  std::atomic<size_t> active_workers_;
+  std::atomic<uint32_t> hot_events_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitLoadController);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_LOAD_CONTROLLER_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit_load_controller.h"
+
+#include "gtest/gtest.h"
+
+namespace art {
+namespace jit {
+
+static JitLoadController::Sample MakeSample(double load_average,
+                                            size_t queue_length = 0u,
+                                            uint64_t compile_cpu_ns = 0u) {
+  JitLoadController::Sample sample;
+  sample.queue_length = queue_length;
+  sample.compile_cpu_ns = compile_cpu_ns;
+  sample.wall_ns = JitLoadController::kSampleIntervalNs;
+  sample.load_average = load_average;
+  sample.num_cpus = 4u;
+  return sample;
+}
+
+TEST(JitLoadControllerTest, DefaultBehavior) {
+  JitLoadController controller(/* max_workers= */ 2u);
+  EXPECT_EQ(controller.GetLevel(), 0);
+  EXPECT_EQ(controller.GetActiveWorkers(), 1u);
+  EXPECT_FALSE(controller.ShouldCompileOptimizedDirectly());
+  for (size_t i = 0; i != 8u; ++i) {
+    EXPECT_TRUE(controller.ShouldEnqueue());
+  }
+}
+
+TEST(JitLoadControllerTest, BacksOffWhenSaturated) {
+  JitLoadController controller(/* max_workers= */ 2u);
+  controller.Update(MakeSample(/* load_average= */ 6.0));
+  EXPECT_EQ(controller.GetLevel(), 1);
+  // Half of the hot methods get enqueued.
+  size_t enqueued = 0u;
+  for (size_t i = 0; i != 8u; ++i) {
+    enqueued += controller.ShouldEnqueue() ? 1u : 0u;
+  }
+  EXPECT_EQ(enqueued, 4u);
+
+  // The JIT being the main consumer makes it back off faster.
+  controller.Update(MakeSample(/* load_average= */ 6.0,
+                               /* queue_length= */ 0u,
+                               /* compile_cpu_ns= */ JitLoadController::kSampleIntervalNs));
+  EXPECT_EQ(controller.GetLevel(), 3);
+
+  for (size_t i = 0; i != 10u; ++i) {
+    controller.Update(MakeSample(/* load_average= */ 6.0));
+  }
+  EXPECT_EQ(controller.GetLevel(), JitLoadController::kMaxLevel);
+
+  // Recovers one level per sample once the load drops.
+  controller.Update(MakeSample(/* load_average= */ 3.0));
+  EXPECT_EQ(controller.GetLevel(), JitLoadController::kMaxLevel - 1);
+}
+
+TEST(JitLoadControllerTest, EagerWhenIdle) {
+  JitLoadController controller(/* max_workers= */ 2u);
+  controller.Update(MakeSample(/* load_average= */ 0.5, /* queue_length= */ 10u));
+  EXPECT_EQ(controller.GetLevel(), JitLoadController::kMinLevel);
+  EXPECT_TRUE(controller.ShouldCompileOptimizedDirectly());
+  EXPECT_EQ(controller.GetActiveWorkers(), 2u);
+
+  // Back to default as soon as there is some load.
+  controller.Update(MakeSample(/* load_average= */ 3.0, /* queue_length= */ 10u));
+  EXPECT_EQ(controller.GetLevel(), 0);
+  EXPECT_FALSE(controller.ShouldCompileOptimizedDirectly());
+  EXPECT_EQ(controller.GetActiveWorkers(), 1u);
+}
+
+TEST(JitLoadControllerTest, IgnoresMissingLoadAverage) {
+  JitLoadController controller(/* max_workers= */ 1u);
+  controller.Update(MakeSample(/* load_average= */ 6.0));
+  controller.Update(MakeSample(/* load_average= */ -1.0));
+  EXPECT_EQ(controller.GetLevel(), 1);
+}
+
+}  // namespace jit
+}  // namespace art
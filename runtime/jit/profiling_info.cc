@@ -17,6 +17,7 @@
 #include "profiling_info.h"
 
 #include "art_method-inl.h"
+#include "dex/dex_file_types.h"
 #include "dex/dex_instruction.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
@@ -29,7 +30,14 @@ ProfilingInfo::ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& ent
       : baseline_hotness_count_(GetOptimizeThreshold()),
         method_(method),
         number_of_inline_caches_(entries.size()),
-        current_inline_uses_(0) {
+        current_inline_uses_(0),
+        next_deoptimization_dex_pc_(0u) {
+  for (std::atomic<uint16_t>& count : deoptimization_counts_) {
+    count.store(0u, std::memory_order_relaxed);
+  }
+  for (std::atomic<uint32_t>& dex_pc : deoptimization_dex_pcs_) {
+    dex_pc.store(dex::kDexNoIndex, std::memory_order_relaxed);
+  }
   memset(&cache_, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
     cache_[i].dex_pc_ = entries[i];
@@ -110,6 +118,29 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   // as the garbage collector might clear the entries concurrently.
 }
 
+void ProfilingInfo::AddDeoptimization(DeoptimizationKind kind, uint32_t dex_pc) {
+  std::atomic<uint16_t>& count = deoptimization_counts_[static_cast<size_t>(kind)];
+  // Concurrent updates may lose an increment, which is fine for a heuristic.
+  uint16_t old_count = count.load(std::memory_order_relaxed);
+  if (old_count != std::numeric_limits<uint16_t>::max()) {
+    count.store(old_count + 1u, std::memory_order_relaxed);
+  }
+  if (!HasDeoptimizedAt(dex_pc)) {
+    uint32_t index = next_deoptimization_dex_pc_.fetch_add(1u, std::memory_order_relaxed);
+    deoptimization_dex_pcs_[index % kNumberOfDeoptimizationDexPcs].store(
+        dex_pc, std::memory_order_relaxed);
+  }
+}
+
+bool ProfilingInfo::HasDeoptimizedAt(uint32_t dex_pc) const {
+  for (const std::atomic<uint32_t>& entry : deoptimization_dex_pcs_) {
+    if (entry.load(std::memory_order_relaxed) == dex_pc) {
+      return true;
+    }
+  }
+  return false;
+}
+
 ScopedProfilingInfoUse::ScopedProfilingInfoUse(jit::Jit* jit, ArtMethod* method, Thread* self)
     : jit_(jit),
       method_(method),
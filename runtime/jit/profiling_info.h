@@ -17,10 +17,12 @@
 #ifndef ART_RUNTIME_JIT_PROFILING_INFO_H_
 #define ART_RUNTIME_JIT_PROFILING_INFO_H_
 
+#include <atomic>
 #include <vector>
 
 #include "base/macros.h"
 #include "base/value_object.h"
+#include "deoptimization_kind.h"
 #include "gc_root.h"
 #include "interpreter/mterp/nterp.h"
 #include "offsets.h"
@@ -119,6 +121,22 @@ class ProfilingInfo {
     return baseline_hotness_count_;
   }
 
+  // Number of deoptimizations of a given kind after which the compiler stops
+  // emitting the corresponding speculation when recompiling the method.
+  static constexpr uint16_t kDeoptimizationFeedbackThreshold = 2;
+
+  // Record that compiled code for the method deoptimized with `kind` at `dex_pc`.
+  // For deoptimizations in inlined code, `dex_pc` is the one of the outermost
+  // call site in this method.
+  void AddDeoptimization(DeoptimizationKind kind, uint32_t dex_pc);
+
+  uint16_t GetDeoptimizationCount(DeoptimizationKind kind) const {
+    return deoptimization_counts_[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+  }
+
+  // Return whether one of the most recent deoptimizations happened at `dex_pc`.
+  bool HasDeoptimizedAt(uint32_t dex_pc) const;
+
  private:
   ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries);
 
@@ -141,6 +159,14 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // Saturating counts of deoptimizations, indexed by `DeoptimizationKind`.
+  std::atomic<uint16_t> deoptimization_counts_[static_cast<size_t>(DeoptimizationKind::kLast) + 1];
+
+  // Dex pcs of the most recent deoptimizations, used as a ring buffer.
+  static constexpr size_t kNumberOfDeoptimizationDexPcs = 4;
+  std::atomic<uint32_t> deoptimization_dex_pcs_[kNumberOfDeoptimizationDexPcs];
+  std::atomic<uint32_t> next_deoptimization_dex_pc_;
+
   // Dynamically allocated array of size `number_of_inline_caches_`.
   InlineCache cache_[0];
 
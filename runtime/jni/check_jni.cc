@@ -54,13 +54,13 @@ namespace art {
 
 // This helper cannot be in the anonymous namespace because it needs to be
 // declared as a friend by JniVmExt and JniEnvExt.
+// Global references are spread over several tables, see JavaVMExt::IsValidGlobalReference().
 inline IndirectReferenceTable* GetIndirectReferenceTable(ScopedObjectAccess& soa,
                                                          IndirectRefKind kind) {
   DCHECK_NE(kind, kJniTransitionOrInvalid);
+  DCHECK_NE(kind, kGlobal);
   JNIEnvExt* env = soa.Env();
-  IndirectReferenceTable* irt =
-      (kind == kLocal) ? &env->locals_
-                       : ((kind == kGlobal) ? &env->vm_->globals_ : &env->vm_->weak_globals_);
+  IndirectReferenceTable* irt = (kind == kLocal) ? &env->locals_ : &env->vm_->weak_globals_;
   DCHECK_EQ(irt->GetKind(), kind);
   return irt;
 }
@@ -874,8 +874,13 @@ class ScopedCheck {
         obj = soa.Decode<mirror::Object>(java_object);
       }
     } else {
-      IndirectReferenceTable* irt = GetIndirectReferenceTable(soa, ref_kind);
-      okay = irt->IsValidReference(java_object, &error_msg);
+      IndirectReferenceTable* irt = nullptr;
+      if (ref_kind == kGlobal) {
+        okay = soa.Env()->GetVm()->IsValidGlobalReference(ref, &error_msg);
+      } else {
+        irt = GetIndirectReferenceTable(soa, ref_kind);
+        okay = irt->IsValidReference(java_object, &error_msg);
+      }
       DCHECK_EQ(okay, error_msg.empty());
       if (okay) {
         // Note: The `IsValidReference()` checks for null but we do not prevent races,
@@ -19,6 +19,7 @@
 
 #include "java_vm_ext.h"
 
+#include "indirect_reference_table-inl.h"
 #include "read_barrier_config.h"
 #include "thread-inl.h"
 
@@ -31,6 +32,17 @@ inline bool JavaVMExt::MayAccessWeakGlobals(Thread* self) const {
       : allow_accessing_weak_globals_.load(std::memory_order_seq_cst);
 }
 
+inline JavaVMExt::GlobalsShard* JavaVMExt::GetGlobalsShard(IndirectRef ref) const {
+  DCHECK_EQ(IndirectReferenceTable::GetIndirectRefKind(ref), kGlobal);
+  return globals_[IndirectReferenceTable::DecodeShard(ref, kGlobalsShardBits)].get();
+}
+
+template<ReadBarrierOption kReadBarrierOption>
+inline ObjPtr<mirror::Object> JavaVMExt::GetGlobal(IndirectRef ref) const {
+  return GetGlobalsShard(ref)->table.SynchronizedGet<kReadBarrierOption>(
+      IndirectReferenceTable::RemoveShard(ref, kGlobalsShardBits));
+}
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_JNI_JAVA_VM_EXT_INL_H_
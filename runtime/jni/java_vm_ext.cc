@@ -506,7 +506,7 @@ JavaVMExt::JavaVMExt(Runtime* runtime,
       tracing_enabled_(runtime_options.Exists(RuntimeArgumentMap::JniTrace)
                        || VLOG_IS_ON(third_party_jni)),
       trace_(runtime_options.GetOrDefault(RuntimeArgumentMap::JniTrace)),
-      globals_(kGlobalsMax, kGlobal, IndirectReferenceTable::ResizableCapacity::kNo, error_msg),
+      num_globals_(0u),
       libraries_(new Libraries),
       unchecked_functions_(&gJniInvokeInterface),
       weak_globals_(kWeakGlobalsMax,
@@ -525,12 +525,20 @@ JavaVMExt::JavaVMExt(Runtime* runtime,
       old_allocation_tracking_state_(false) {
   functions = unchecked_functions_;
   SetCheckJniEnabled(runtime_options.Exists(RuntimeArgumentMap::CheckJni) || kIsDebugBuild);
+  static_assert(kGlobalsMax % kGlobalsShards == 0u);
+  for (std::unique_ptr<GlobalsShard>& globals : globals_) {
+    globals = std::make_unique<GlobalsShard>(kGlobalsMax / kGlobalsShards, error_msg);
+  }
 }
 
 JavaVMExt::~JavaVMExt() {
   UnloadBootNativeLibraries();
 }
 
+JavaVMExt::GlobalsShard::GlobalsShard(size_t max_count, std::string* error_msg)
+    : lock("JNI global reference table lock", kJniGlobalsLock),
+      table(max_count, kGlobal, IndirectReferenceTable::ResizableCapacity::kNo, error_msg) {}
+
 // Checking "globals" and "weak_globals" usually requires locks, but we
 // don't need the locks to check for validity when constructing the
 // object. Use NO_THREAD_SAFETY_ANALYSIS for this.
@@ -538,10 +546,15 @@ std::unique_ptr<JavaVMExt> JavaVMExt::Create(Runtime* runtime,
                                              const RuntimeArgumentMap& runtime_options,
                                              std::string* error_msg) NO_THREAD_SAFETY_ANALYSIS {
   std::unique_ptr<JavaVMExt> java_vm(new JavaVMExt(runtime, runtime_options, error_msg));
-  if (java_vm && java_vm->globals_.IsValid() && java_vm->weak_globals_.IsValid()) {
-    return java_vm;
+  if (java_vm == nullptr || !java_vm->weak_globals_.IsValid()) {
+    return nullptr;
   }
-  return nullptr;
+  for (const std::unique_ptr<GlobalsShard>& globals : java_vm->globals_) {
+    if (!globals->table.IsValid()) {
+      return nullptr;
+    }
+  }
+  return java_vm;
 }
 
 jint JavaVMExt::HandleGetEnv(/*out*/void** env, jint version) {
@@ -646,7 +659,7 @@ void JavaVMExt::CheckGlobalRefAllocationTracking() {
   if (LIKELY(enable_allocation_tracking_delta_ == 0)) {
     return;
   }
-  size_t simple_free_capacity = globals_.FreeCapacity();
+  size_t simple_free_capacity = kGlobalsMax - num_globals_.load(std::memory_order_relaxed);
   if (UNLIKELY(simple_free_capacity <= enable_allocation_tracking_delta_)) {
     if (!allocation_tracking_enabled_) {
       LOG(WARNING) << "Global reference storage appears close to exhaustion, program termination "
@@ -676,9 +689,9 @@ void JavaVMExt::CheckGlobalRefAllocationTracking() {
 }
 
 void JavaVMExt::MaybeTraceGlobals() {
-  if (global_ref_report_counter_++ == kGlobalRefReportInterval) {
-    global_ref_report_counter_ = 1;
-    ATraceIntegerValue("JNI Global Refs", globals_.NEntriesForGlobal());
+  uint32_t counter = global_ref_report_counter_.fetch_add(1u, std::memory_order_relaxed);
+  if (counter % kGlobalRefReportInterval == 0u) {
+    ATraceIntegerValue("JNI Global Refs", num_globals_.load(std::memory_order_relaxed));
   }
 }
 
@@ -694,17 +707,30 @@ jobject JavaVMExt::AddGlobalRef(Thread* self, ObjPtr<mirror::Object> obj) {
   if (obj == nullptr) {
     return nullptr;
   }
-  IndirectRef ref;
+  IndirectRef ref = nullptr;
   std::string error_msg;
-  {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-    ref = globals_.Add(kIRTFirstSegment, obj, &error_msg);
-    MaybeTraceGlobals();
+  uint32_t first_shard = self->GetThreadId();
+  for (size_t i = 0; i != kGlobalsShards && ref == nullptr; ++i) {
+    uint32_t shard = (first_shard + i) & (kGlobalsShards - 1u);
+    GlobalsShard* globals = globals_[shard].get();
+    MutexLock mu(self, globals->lock);
+    // Skip full tables without building an overflow message, unless this is the last one.
+    // A table with no free capacity at the top may still have holes, but they are left for
+    // the threads that start with this shard.
+    if (globals->table.FreeCapacity() == 0u && i + 1u != kGlobalsShards) {
+      continue;
+    }
+    IndirectRef shard_ref = globals->table.Add(kIRTFirstSegment, obj, &error_msg);
+    if (shard_ref != nullptr) {
+      ref = IndirectReferenceTable::EncodeShard(shard_ref, shard, kGlobalsShardBits);
+    }
   }
   if (UNLIKELY(ref == nullptr)) {
     LOG(FATAL) << error_msg;
     UNREACHABLE();
   }
+  num_globals_.fetch_add(1u, std::memory_order_relaxed);
+  MaybeTraceGlobals();
   CheckGlobalRefAllocationTracking();
   return reinterpret_cast<jobject>(ref);
 }
@@ -747,14 +773,29 @@ void JavaVMExt::DeleteGlobalRef(Thread* self, jobject obj) {
   if (obj == nullptr) {
     return;
   }
+  // References of other kinds are passed unchanged to the first table, which knows how to
+  // handle (or report) them.
+  bool is_global = IndirectReferenceTable::GetIndirectRefKind(obj) == kGlobal;
+  GlobalsShard* globals = globals_[0].get();
+  IndirectRef shard_ref = obj;
+  if (LIKELY(is_global)) {
+    globals = GetGlobalsShard(obj);
+    shard_ref = IndirectReferenceTable::RemoveShard(obj, kGlobalsShardBits);
+  }
+  bool removed;
   {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-    if (!globals_.Remove(kIRTFirstSegment, obj)) {
-      LOG(WARNING) << "JNI WARNING: DeleteGlobalRef(" << obj << ") "
-                   << "failed to find entry";
+    MutexLock mu(self, globals->lock);
+    removed = globals->table.Remove(kIRTFirstSegment, shard_ref);
+  }
+  if (removed) {
+    if (is_global) {
+      num_globals_.fetch_sub(1u, std::memory_order_relaxed);
     }
-    MaybeTraceGlobals();
+  } else {
+    LOG(WARNING) << "JNI WARNING: DeleteGlobalRef(" << obj << ") "
+                 << "failed to find entry";
   }
+  MaybeTraceGlobals();
   CheckGlobalRefAllocationTracking();
 }
 
@@ -790,10 +831,12 @@ void JavaVMExt::DumpForSigQuit(std::ostream& os) {
     os << " (with forcecopy)";
   }
   Thread* self = Thread::Current();
-  {
-    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-    os << "; globals=" << globals_.Capacity();
+  size_t globals_capacity = 0u;
+  for (const std::unique_ptr<GlobalsShard>& globals : globals_) {
+    MutexLock mu(self, globals->lock);
+    globals_capacity += globals->table.Capacity();
   }
+  os << "; globals=" << globals_capacity;
   {
     MutexLock mu(self, *Locks::jni_weak_globals_lock_);
     if (weak_globals_.Capacity() > 0) {
@@ -834,12 +877,18 @@ void JavaVMExt::BroadcastForNewWeakGlobals() {
 }
 
 ObjPtr<mirror::Object> JavaVMExt::DecodeGlobal(IndirectRef ref) {
-  return globals_.SynchronizedGet(ref);
+  return GetGlobal(ref);
 }
 
 void JavaVMExt::UpdateGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::Object> result) {
-  WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-  globals_.Update(ref, result);
+  GlobalsShard* globals = GetGlobalsShard(ref);
+  MutexLock mu(self, globals->lock);
+  globals->table.Update(IndirectReferenceTable::RemoveShard(ref, kGlobalsShardBits), result);
+}
+
+bool JavaVMExt::IsValidGlobalReference(IndirectRef ref, /*out*/std::string* error_msg) {
+  return GetGlobalsShard(ref)->table.IsValidReference(
+      IndirectReferenceTable::RemoveShard(ref, kGlobalsShardBits), error_msg);
 }
 
 ObjPtr<mirror::Object> JavaVMExt::DecodeWeakGlobal(Thread* self, IndirectRef ref) {
@@ -901,8 +950,17 @@ void JavaVMExt::UpdateWeakGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::O
 void JavaVMExt::DumpReferenceTables(std::ostream& os) {
   Thread* self = Thread::Current();
   {
-    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-    globals_.Dump(os);
+    // Dump the references of all global tables together.
+    ReferenceTable entries("JNI global", /* initial_size= */ 16u, kGlobalsMax);
+    for (const std::unique_ptr<GlobalsShard>& globals : globals_) {
+      MutexLock mu(self, globals->lock);
+      for (GcRoot<mirror::Object>* ref : globals->table) {
+        if (!ref->IsNull()) {
+          entries.Add(ref->Read());
+        }
+      }
+    }
+    entries.Dump(os);
   }
   {
     MutexLock mu(self, *Locks::jni_weak_globals_lock_);
@@ -1190,14 +1248,19 @@ void JavaVMExt::SweepJniWeakGlobals(IsMarkedVisitor* visitor) {
 }
 
 void JavaVMExt::TrimGlobals() {
-  WriterMutexLock mu(Thread::Current(), *Locks::jni_globals_lock_);
-  globals_.Trim();
+  Thread* self = Thread::Current();
+  for (const std::unique_ptr<GlobalsShard>& globals : globals_) {
+    MutexLock mu(self, globals->lock);
+    globals->table.Trim();
+  }
 }
 
 void JavaVMExt::VisitRoots(RootVisitor* visitor) {
   Thread* self = Thread::Current();
-  ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-  globals_.VisitRoots(visitor, RootInfo(kRootJNIGlobal));
+  for (const std::unique_ptr<GlobalsShard>& globals : globals_) {
+    MutexLock mu(self, globals->lock);
+    globals->table.VisitRoots(visitor, RootInfo(kRootJNIGlobal));
+  }
   // The weak_globals table is visited by the GC itself (because it mutates the table).
 }
 
@@ -19,6 +19,10 @@
 
 #include "jni.h"
 
+#include <array>
+#include <atomic>
+#include <memory>
+
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "indirect_reference_table.h"
@@ -128,19 +132,16 @@ class JavaVMExt : public JavaVM {
 
   void DumpForSigQuit(std::ostream& os)
       REQUIRES(!Locks::jni_libraries_lock_,
-               !Locks::jni_globals_lock_,
                !Locks::jni_weak_globals_lock_);
 
   void DumpReferenceTables(std::ostream& os)
       REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_globals_lock_,
-               !Locks::jni_weak_globals_lock_,
+      REQUIRES(!Locks::jni_weak_globals_lock_,
                !Locks::alloc_tracker_lock_);
 
   bool SetCheckJniEnabled(bool enabled);
 
-  void VisitRoots(RootVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_globals_lock_);
+  void VisitRoots(RootVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
 
   void DisallowNewWeakGlobals()
       REQUIRES_SHARED(Locks::mutator_lock_)
@@ -152,14 +153,13 @@ class JavaVMExt : public JavaVM {
       REQUIRES(!Locks::jni_weak_globals_lock_);
 
   jobject AddGlobalRef(Thread* self, ObjPtr<mirror::Object> obj)
-      REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_globals_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_);
 
   jweak AddWeakGlobalRef(Thread* self, ObjPtr<mirror::Object> obj)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::jni_weak_globals_lock_);
 
-  void DeleteGlobalRef(Thread* self, jobject obj) REQUIRES(!Locks::jni_globals_lock_);
+  void DeleteGlobalRef(Thread* self, jobject obj);
 
   void DeleteWeakGlobalRef(Thread* self, jweak obj) REQUIRES(!Locks::jni_weak_globals_lock_);
 
@@ -171,8 +171,11 @@ class JavaVMExt : public JavaVM {
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void UpdateGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::Object> result)
-      REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_globals_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Reference validation for CheckJNI.
+  bool IsValidGlobalReference(IndirectRef ref, /*out*/std::string* error_msg)
+      REQUIRES_SHARED(Locks::mutator_lock_);
 
   ObjPtr<mirror::Object> DecodeWeakGlobal(Thread* self, IndirectRef ref)
       REQUIRES_SHARED(Locks::mutator_lock_)
@@ -201,8 +204,7 @@ class JavaVMExt : public JavaVM {
     return unchecked_functions_;
   }
 
-  void TrimGlobals() REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_globals_lock_);
+  void TrimGlobals() REQUIRES_SHARED(Locks::mutator_lock_);
 
   jint HandleGetEnv(/*out*/void** env, jint version)
       REQUIRES(!env_hooks_lock_);
@@ -229,9 +231,27 @@ class JavaVMExt : public JavaVM {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::jni_weak_globals_lock_);
 
+  // Global references are spread over several tables, each guarded by its own lock, so that
+  // threads adding and deleting global references at the same time rarely contend. A thread
+  // adds to the table selected by its thread id and moves on to the next ones when it is full.
+  static constexpr size_t kGlobalsShardBits = 3u;
+  static constexpr size_t kGlobalsShards = 1u << kGlobalsShardBits;
+
+  struct GlobalsShard {
+    GlobalsShard(size_t max_count, std::string* error_msg);
+
+    Mutex lock;
+    IndirectReferenceTable table;
+  };
+
+  GlobalsShard* GetGlobalsShard(IndirectRef ref) const;
+
+  template<ReadBarrierOption kReadBarrierOption = kWithReadBarrier>
+  ObjPtr<mirror::Object> GetGlobal(IndirectRef ref) const REQUIRES_SHARED(Locks::mutator_lock_);
+
   void CheckGlobalRefAllocationTracking();
 
-  inline void MaybeTraceGlobals() REQUIRES(Locks::jni_globals_lock_);
+  inline void MaybeTraceGlobals();
   inline void MaybeTraceWeakGlobals() REQUIRES(Locks::jni_weak_globals_lock_);
 
   Runtime* const runtime_;
@@ -248,8 +268,11 @@ class JavaVMExt : public JavaVM {
   // Extra diagnostics.
   const std::string trace_;
 
-  // Not guarded by globals_lock since we sometimes use SynchronizedGet in Thread::DecodeJObject.
-  IndirectReferenceTable globals_;
+  // The tables are not guarded by their locks for reading since we sometimes use SynchronizedGet
+  // in Thread::DecodeJObject.
+  std::array<std::unique_ptr<GlobalsShard>, kGlobalsShards> globals_;
+  // Number of global references in all tables.
+  std::atomic<size_t> num_globals_;
 
   // No lock annotation since UnloadNativeLibraries is called on libraries_ but locks the
   // jni_libraries_lock_ internally.
@@ -279,10 +302,9 @@ class JavaVMExt : public JavaVM {
   static constexpr uint32_t kGlobalRefReportInterval = 17;
   uint32_t weak_global_ref_report_counter_ GUARDED_BY(Locks::jni_weak_globals_lock_)
       = kGlobalRefReportInterval;
-  uint32_t global_ref_report_counter_ GUARDED_BY(Locks::jni_globals_lock_)
-      = kGlobalRefReportInterval;
+  std::atomic<uint32_t> global_ref_report_counter_ = 0u;
 
-  friend class linker::ImageWriter;  // Uses `globals_` and `weak_globals_` without read barrier.
+  friend class linker::ImageWriter;  // Uses `GetGlobal()` and `weak_globals_` without read barrier.
   friend IndirectReferenceTable* GetIndirectReferenceTable(ScopedObjectAccess& soa,
                                                            IndirectRefKind kind);
 
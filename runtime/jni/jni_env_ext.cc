@@ -21,6 +21,7 @@
 
 #include "android-base/stringprintf.h"
 
+#include "base/bit_utils.h"
 #include "base/mutex.h"
 #include "base/to_str.h"
 #include "check_jni.h"
@@ -77,10 +78,10 @@ JNIEnvExt::JNIEnvExt(Thread* self_in, JavaVMExt* vm_in, std::string* error_msg)
     : self_(self_in),
       vm_(vm_in),
       local_ref_cookie_(kIRTFirstSegment),
+      check_jni_(false),
       locals_(1, kLocal, IndirectReferenceTable::ResizableCapacity::kYes, error_msg),
       monitors_("monitors", kMonitorsInitial, kMonitorsMax),
       critical_(0),
-      check_jni_(false),
       runtime_deleted_(false) {
   MutexLock mu(Thread::Current(), *Locks::jni_function_table_lock_);
   check_jni_ = vm_in->IsCheckJniEnabled();
@@ -151,14 +152,23 @@ static size_t JNIEnvSize(size_t pointer_size) {
   return pointer_size;
 }
 
+static size_t LocalsOffset(size_t pointer_size) {
+  return RoundUp(JNIEnvSize(pointer_size) +
+                     2 * pointer_size +              // Thread* self + JavaVMExt* vm.
+                     4 +                             // local_ref_cookie.
+                     1,                              // check_jni.
+                 pointer_size);                      // Padding.
+}
+
 MemberOffset JNIEnvExt::SegmentStateOffset(size_t pointer_size) {
-  size_t locals_offset = JNIEnvSize(pointer_size) +
-                         2 * pointer_size +          // Thread* self + JavaVMExt* vm.
-                         4 +                         // local_ref_cookie.
-                         (pointer_size - 4);         // Padding.
   size_t irt_segment_state_offset =
       IndirectReferenceTable::SegmentStateOffset(pointer_size).Int32Value();
-  return MemberOffset(locals_offset + irt_segment_state_offset);
+  return MemberOffset(LocalsOffset(pointer_size) + irt_segment_state_offset);
+}
+
+MemberOffset JNIEnvExt::LocalsTableOffset(size_t pointer_size) {
+  size_t irt_table_offset = IndirectReferenceTable::TableOffset(pointer_size).Int32Value();
+  return MemberOffset(LocalsOffset(pointer_size) + irt_table_offset);
 }
 
 MemberOffset JNIEnvExt::LocalRefCookieOffset(size_t pointer_size) {
@@ -170,6 +180,12 @@ MemberOffset JNIEnvExt::SelfOffset(size_t pointer_size) {
   return MemberOffset(JNIEnvSize(pointer_size));
 }
 
+MemberOffset JNIEnvExt::CheckJniOffset(size_t pointer_size) {
+  return MemberOffset(JNIEnvSize(pointer_size) +
+                      2 * pointer_size +          // Thread* self + JavaVMExt* vm
+                      4);                         // local_ref_cookie.
+}
+
 // Use some defining part of the caller's frame as the identifying mark for the JNI segment.
 static uintptr_t GetJavaCallFrame(Thread* self) REQUIRES_SHARED(Locks::mutator_lock_) {
   NthCallerVisitor zeroth_caller(self, 0, false);
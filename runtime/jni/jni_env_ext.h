@@ -45,6 +45,8 @@ class JNIEnvExt : public JNIEnv {
   static MemberOffset SegmentStateOffset(size_t pointer_size);
   static MemberOffset LocalRefCookieOffset(size_t pointer_size);
   static MemberOffset SelfOffset(size_t pointer_size);
+  static MemberOffset CheckJniOffset(size_t pointer_size);
+  static MemberOffset LocalsTableOffset(size_t pointer_size);
   static jint GetEnvHandler(JavaVMExt* vm, /*out*/void** out, jint version);
 
   ~JNIEnvExt();
@@ -174,6 +176,10 @@ class JNIEnvExt : public JNIEnv {
   // Cookie used when using the local indirect reference table.
   IRTSegmentState local_ref_cookie_;
 
+  // Frequently-accessed fields cached from JavaVM. Kept next to the cookie so that JNI stubs
+  // can check it at a fixed offset.
+  bool check_jni_;
+
   // JNI local references.
   IndirectReferenceTable locals_ GUARDED_BY(Locks::mutator_lock_);
 
@@ -200,9 +206,6 @@ class JNIEnvExt : public JNIEnv {
   // How many nested "critical" JNI calls are we in? Used by CheckJNI to ensure that criticals are
   uint32_t critical_;
 
-  // Frequently-accessed fields cached from JavaVM.
-  bool check_jni_;
-
   // If we are a JNI env for a daemon thread with a deleted runtime.
   std::atomic<bool> runtime_deleted_;
 
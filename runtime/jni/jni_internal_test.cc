@@ -2615,6 +2615,15 @@ TEST_F(JniInternalTest, JNIEnvExtOffsets) {
       IndirectReferenceTable::SegmentStateOffset(sizeof(void*)).Uint32Value();
   uint32_t segment_state_computed = JNIEnvExt::SegmentStateOffset(sizeof(void*)).Uint32Value();
   EXPECT_EQ(segment_state_now, segment_state_computed);
+
+  EXPECT_EQ(OFFSETOF_MEMBER(JNIEnvExt, check_jni_),
+            JNIEnvExt::CheckJniOffset(sizeof(void*)).Uint32Value());
+
+  uint32_t locals_table_now =
+      OFFSETOF_MEMBER(JNIEnvExt, locals_) +
+      IndirectReferenceTable::TableOffset(sizeof(void*)).Uint32Value();
+  uint32_t locals_table_computed = JNIEnvExt::LocalsTableOffset(sizeof(void*)).Uint32Value();
+  EXPECT_EQ(locals_table_now, locals_table_computed);
 }
 
 static size_t gGlobalRefCount = 0;
@@ -106,6 +106,18 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
     case DatumId::kFullGcTracingThroughputAvg:
       return std::make_optional(
           statsd::ART_DATUM_REPORTED__KIND__ART_DATUM_GC_FULL_HEAP_TRACING_THROUGHPUT_AVG_MB_PER_SEC);
+    case DatumId::kJitMethodCompileFailureCount:
+    case DatumId::kJitMethodCompileTime:
+    case DatumId::kJitMethodQueueWaitTime:
+    case DatumId::kJitMethodCodeSize:
+    case DatumId::kJitAdaptiveDeferredCount:
+    case DatumId::kJitAdaptiveSkippedBaselineCount:
+    case DatumId::kMonitorContentionWaitTime:
+    case DatumId::kMonitorSpinSuccessCount:
+    case DatumId::kMonitorSpinFailureCount:
+    case DatumId::kTimeToSafepoint:
+      // No corresponding atom in atoms.proto yet.
+      return std::nullopt;
   }
 }
 
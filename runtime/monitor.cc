@@ -97,6 +97,9 @@ void Monitor::Init(uint32_t lock_profiling_threshold,
 Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_limit_(kInitialMonitorSpins),
+      spin_successes_(0),
+      spin_failures_(0),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -131,6 +134,9 @@ Monitor::Monitor(Thread* self,
                  MonitorId id)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_limit_(kInitialMonitorSpins),
+      spin_successes_(0),
+      spin_failures_(0),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -426,8 +432,12 @@ bool Monitor::TryLock(Thread* self, bool spin) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
-        : monitor_lock_.ExclusiveTryLock(self);
+    bool success = monitor_lock_.ExclusiveTryLock(self);
+    if (!success && spin) {
+      success = monitor_lock_.ExclusiveTryLockWithSpinning(
+          self, spin_limit_.load(std::memory_order_relaxed));
+      UpdateSpinLimit(success);
+    }
     if (!success) {
       return false;
     }
@@ -443,6 +453,34 @@ bool Monitor::TryLock(Thread* self, bool spin) {
   return true;
 }
 
+void Monitor::UpdateSpinLimit(bool success) {
+  // As with adaptive spinning in other VMs, spin longer on monitors for which spinning
+  // recently paid off, i.e. that are held for short periods, and quickly stop spinning on
+  // monitors held for long periods, for which blocking is cheaper than burning CPU.
+  // Races between contending threads only make the limit less precise.
+  static constexpr size_t kSpinBonus = 2;
+  size_t limit = spin_limit_.load(std::memory_order_relaxed);
+  if (success) {
+    spin_successes_.fetch_add(1, std::memory_order_relaxed);
+    limit = std::min(limit + kSpinBonus, kMaxMonitorSpins);
+    Runtime::Current()->GetMetrics()->MonitorSpinSuccessCount()->AddOne();
+  } else {
+    spin_failures_.fetch_add(1, std::memory_order_relaxed);
+    limit = std::max(limit / 2, kMinMonitorSpins);
+    Runtime::Current()->GetMetrics()->MonitorSpinFailureCount()->AddOne();
+  }
+  spin_limit_.store(dchecked_integral_cast<uint8_t>(limit), std::memory_order_relaxed);
+}
+
+std::string Monitor::PrettySpinInfo() const {
+  uint32_t successes = spin_successes_.load(std::memory_order_relaxed);
+  uint32_t failures = spin_failures_.load(std::memory_order_relaxed);
+  return StringPrintf(" (spinning succeeded for %u of %u contended acquisitions, limit=%u)",
+                      successes,
+                      successes + failures,
+                      static_cast<uint32_t>(spin_limit_.load(std::memory_order_relaxed)));
+}
+
 template <LockReason reason>
 void Monitor::Lock(Thread* self) {
   bool called_monitors_callback = false;
@@ -456,7 +494,8 @@ void Monitor::Lock(Thread* self) {
   }
   // Contended; not reentrant. We hold no locks, so tread carefully.
   const bool log_contention = (lock_profiling_threshold_ != 0);
-  uint64_t wait_start_ms = log_contention ? MilliTime() : 0;
+  uint64_t wait_start_ns = NanoTime();
+  uint64_t wait_ns = 0u;
 
   Thread *orig_owner = nullptr;
   ArtMethod* owners_method;
@@ -522,10 +561,11 @@ void Monitor::Lock(Thread* self) {
     // We already tried spinning above. The shutdown procedure currently assumes we stop
     // touching monitors shortly after we suspend, so don't spin again here.
     monitor_lock_.ExclusiveLock(self);
+    wait_ns = NanoTime() - wait_start_ns;
 
     if (log_contention && orig_owner != nullptr) {
       // Woken from contention.
-      uint64_t wait_ms = MilliTime() - wait_start_ms;
+      uint64_t wait_ms = NsToMs(wait_ns);
       uint32_t sample_percent;
       if (wait_ms >= lock_profiling_threshold_) {
         sample_percent = 100;
@@ -595,7 +635,7 @@ void Monitor::Lock(Thread* self) {
                                         owners_dex_pc,
                                         num_waiters)
                 << " in " << ArtMethod::PrettyMethod(m) << " for "
-                << PrettyDuration(MsToNs(wait_ms)) << "\n"
+                << PrettyDuration(MsToNs(wait_ms)) << PrettySpinInfo() << "\n"
                 << "Current owner stack:\n" << owner_stack_dump
                 << "Contender stack:\n" << self_trace_oss.str();
           } else if (wait_ms > kLongWaitMs && owners_method != nullptr) {
@@ -609,7 +649,7 @@ void Monitor::Lock(Thread* self) {
                                         owners_dex_pc,
                                         num_waiters)
                 << " in " << ArtMethod::PrettyMethod(m) << " for "
-                << PrettyDuration(MsToNs(wait_ms));
+                << PrettyDuration(MsToNs(wait_ms)) << PrettySpinInfo();
           }
           LogContentionEvent(self,
                             wait_ms,
@@ -623,6 +663,8 @@ void Monitor::Lock(Thread* self) {
     }
   }
   // We've successfully acquired monitor_lock_, released thread_list_lock, and are runnable.
+  // Only touch the runtime metrics now, the runtime may be shutting down while we are blocked.
+  Runtime::Current()->GetMetrics()->MonitorContentionWaitTime()->Add(NsToUs(wait_ns));
 
   // We avoided touching monitor fields while suspended, so set owner_ here.
   owner_.store(self, std::memory_order_relaxed);
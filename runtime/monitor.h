@@ -67,6 +67,12 @@ class Monitor {
 
   static constexpr int kMonitorTimeoutMaxMs = 1000;  // 1 second
 
+  // Bounds and initial value of the number of brief waits for a contended monitor to be
+  // released before blocking on it. See Monitor::UpdateSpinLimit.
+  static constexpr size_t kMinMonitorSpins = 1;
+  static constexpr size_t kInitialMonitorSpins = Mutex::kDefaultMaxSpins;
+  static constexpr size_t kMaxMonitorSpins = 20;
+
   ~Monitor();
 
   static void Init(uint32_t lock_profiling_threshold, uint32_t stack_dump_lock_profiling_threshold);
@@ -231,6 +237,13 @@ class Monitor {
       TRY_ACQUIRE(true, monitor_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Adapt the spinning period of the next contended acquisitions to whether spinning
+  // succeeded for this one.
+  void UpdateSpinLimit(bool success);
+
+  // Describe how often spinning succeeded for contended acquisitions, for contention logging.
+  std::string PrettySpinInfo() const;
+
   template<LockReason reason = LockReason::kForLock>
   void Lock(Thread* self)
       ACQUIRE(monitor_lock_)
@@ -324,6 +337,14 @@ class Monitor {
   // monitor acquisition. Prevents deflation.
   std::atomic<size_t> num_waiters_;
 
+  // Number of brief waits for the monitor to be released before blocking on it, learned
+  // from past contended acquisitions of this monitor.
+  std::atomic<uint8_t> spin_limit_;
+
+  // Number of contended acquisitions that succeeded while spinning, and that had to block.
+  std::atomic<uint32_t> spin_successes_;
+  std::atomic<uint32_t> spin_failures_;
+
   // Which thread currently owns the lock? monitor_lock_ only keeps the tid.
   // Only set while holding monitor_lock_. Non-locking readers only use it to
   // compare to self or for debugging.
@@ -16,6 +16,9 @@
 
 #include "monitor_pool.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include "base/logging.h"  // For VLOG.
 #include "base/mutex-inl.h"
 #include "monitor.h"
@@ -41,19 +44,34 @@ MonitorPool::MonitorPool()
 void MonitorPool::AllocateChunk() {
   DCHECK(first_free_ == nullptr);
 
-  // Do we need to allocate another chunk list?
-  if (num_chunks_ == current_chunk_list_capacity_) {
-    if (current_chunk_list_capacity_ != 0U) {
-      ++current_chunk_list_index_;
-      CHECK_LT(current_chunk_list_index_, kMaxChunkLists) << "Out of space for inflated monitors";
-      VLOG(monitor) << "Expanding to capacity "
-          << 2 * ChunkListCapacity(current_chunk_list_index_) - kInitialChunkStorage;
-    }  // else we're initializing
-    current_chunk_list_capacity_ = ChunkListCapacity(current_chunk_list_index_);
-    uintptr_t* new_list = new uintptr_t[current_chunk_list_capacity_]();
-    DCHECK(monitor_chunks_[current_chunk_list_index_] == nullptr);
-    monitor_chunks_[current_chunk_list_index_] = new_list;
-    num_chunks_ = 0;
+  size_t list_index;
+  size_t chunk_index;
+  if (!released_chunks_.empty()) {
+    // Reuse the entry of a released chunk, so that the chunk lists do not keep growing.
+    size_t index = released_chunks_.back();
+    released_chunks_.pop_back();
+    list_index = index / kMaxListSize;
+    chunk_index = index % kMaxListSize;
+    DCHECK_EQ(monitor_chunks_[list_index][chunk_index], 0U);
+  } else {
+    // Do we need to allocate another chunk list?
+    if (num_chunks_ == current_chunk_list_capacity_) {
+      if (current_chunk_list_capacity_ != 0U) {
+        ++current_chunk_list_index_;
+        CHECK_LT(current_chunk_list_index_, kMaxChunkLists)
+            << "Out of space for inflated monitors";
+        VLOG(monitor) << "Expanding to capacity "
+            << 2 * ChunkListCapacity(current_chunk_list_index_) - kInitialChunkStorage;
+      }  // else we're initializing
+      current_chunk_list_capacity_ = ChunkListCapacity(current_chunk_list_index_);
+      uintptr_t* new_list = new uintptr_t[current_chunk_list_capacity_]();
+      DCHECK(monitor_chunks_[current_chunk_list_index_] == nullptr);
+      monitor_chunks_[current_chunk_list_index_] = new_list;
+      num_chunks_ = 0;
+    }
+    list_index = current_chunk_list_index_;
+    chunk_index = num_chunks_;
+    num_chunks_++;
   }
 
   // Allocate the chunk.
@@ -64,16 +82,15 @@ void MonitorPool::AllocateChunk() {
   CHECK_EQ(0U, reinterpret_cast<uintptr_t>(chunk) % kMonitorAlignment);
 
   // Add the chunk.
-  monitor_chunks_[current_chunk_list_index_][num_chunks_] = reinterpret_cast<uintptr_t>(chunk);
-  num_chunks_++;
+  monitor_chunks_[list_index][chunk_index] = reinterpret_cast<uintptr_t>(chunk);
 
   // Set up the free list
   Monitor* last = reinterpret_cast<Monitor*>(reinterpret_cast<uintptr_t>(chunk) +
                                              (kChunkCapacity - 1) * kAlignedMonitorSize);
   last->next_free_ = nullptr;
   // Eagerly compute id.
-  last->monitor_id_ = OffsetToMonitorId(current_chunk_list_index_* (kMaxListSize * kChunkSize)
-      + (num_chunks_ - 1) * kChunkSize + (kChunkCapacity - 1) * kAlignedMonitorSize);
+  last->monitor_id_ = OffsetToMonitorId(list_index * (kMaxListSize * kChunkSize)
+      + chunk_index * kChunkSize + (kChunkCapacity - 1) * kAlignedMonitorSize);
   for (size_t i = 0; i < kChunkCapacity - 1; ++i) {
     Monitor* before = reinterpret_cast<Monitor*>(reinterpret_cast<uintptr_t>(last) -
                                                  kAlignedMonitorSize);
@@ -95,8 +112,10 @@ void MonitorPool::FreeInternal() {
     DCHECK_NE(monitor_chunks_[i], static_cast<uintptr_t*>(nullptr));
     for (size_t j = 0; j < ChunkListCapacity(i); ++j) {
       if (i < current_chunk_list_index_ || j < num_chunks_) {
-        DCHECK_NE(monitor_chunks_[i][j], 0U);
-        allocator_.deallocate(reinterpret_cast<uint8_t*>(monitor_chunks_[i][j]), kChunkSize);
+        // Entries of chunks released by ReleaseEmptyChunksInPool() are null.
+        if (monitor_chunks_[i][j] != 0U) {
+          allocator_.deallocate(reinterpret_cast<uint8_t*>(monitor_chunks_[i][j]), kChunkSize);
+        }
       } else {
         DCHECK_EQ(monitor_chunks_[i][j], 0U);
       }
@@ -156,4 +175,43 @@ void MonitorPool::ReleaseMonitorsToPool(Thread* self, MonitorList::Monitors* mon
   }
 }
 
+size_t MonitorPool::ReleaseEmptyChunksInPool(Thread* self) {
+  std::vector<uintptr_t> released;
+  {
+    MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
+    // Count the free monitors in each chunk.
+    std::unordered_map<size_t, size_t> free_counts;
+    for (Monitor* mon = first_free_; mon != nullptr; mon = mon->next_free_) {
+      ++free_counts[MonitorIdToChunkIndex(mon->monitor_id_)];
+    }
+    auto is_in_empty_chunk = [&](Monitor* mon) {
+      return free_counts.find(MonitorIdToChunkIndex(mon->monitor_id_))->second == kChunkCapacity;
+    };
+    // Unlink the monitors of empty chunks from the free list.
+    Monitor** link = &first_free_;
+    while (*link != nullptr) {
+      if (is_in_empty_chunk(*link)) {
+        *link = (*link)->next_free_;
+      } else {
+        link = &(*link)->next_free_;
+      }
+    }
+    // Clear their entries. The chunks may be freed outside the lock, nothing refers to them.
+    for (const auto& [index, count] : free_counts) {
+      if (count == kChunkCapacity) {
+        uintptr_t* entry = &monitor_chunks_[index / kMaxListSize][index % kMaxListSize];
+        DCHECK_NE(*entry, 0U);
+        released.push_back(*entry);
+        *entry = 0U;
+        released_chunks_.push_back(index);
+      }
+    }
+  }
+  for (uintptr_t chunk : released) {
+    allocator_.deallocate(reinterpret_cast<uint8_t*>(chunk), kChunkSize);
+  }
+  VLOG(monitor) << "Released " << released.size() << " empty monitor chunks";
+  return released.size();
+}
+
 }  // namespace art
@@ -22,6 +22,7 @@
 #include "base/allocator.h"
 #ifdef __LP64__
 #include <stdint.h>
+#include <vector>
 #include "base/atomic.h"
 #include "runtime.h"
 #else
@@ -82,6 +83,17 @@ class MonitorPool {
 #endif
   }
 
+  // Return the storage of chunks that only contain free monitors, for example after deflating
+  // the monitors inflated during a contention burst. Returns the number of released chunks.
+  static size_t ReleaseEmptyChunks(Thread* self) {
+#ifndef __LP64__
+    UNUSED(self);
+    return 0u;
+#else
+    return GetMonitorPool()->ReleaseEmptyChunksInPool(self);
+#endif
+  }
+
   static MonitorId MonitorIdFromMonitor(Monitor* mon) {
 #ifndef __LP64__
     return reinterpret_cast<MonitorId>(mon) >> LockWord::kMonitorIdAlignmentShift;
@@ -134,10 +146,13 @@ class MonitorPool {
   void ReleaseMonitorToPool(Thread* self, Monitor* monitor);
   void ReleaseMonitorsToPool(Thread* self, MonitorList::Monitors* monitors);
 
+  size_t ReleaseEmptyChunksInPool(Thread* self) REQUIRES(!Locks::allocated_monitor_ids_lock_);
+
   // Note: This is safe as we do not ever move chunks.  All needed entries in the monitor_chunks_
   // data structure are read-only once we get here.  Updates happen-before this call because
   // the lock word was stored with release semantics and we read it with acquire semantics to
-  // retrieve the id.
+  // retrieve the id. A chunk is released only when all its monitors are free, so no lock word
+  // refers to it, and its entry is set again before any monitor in a new chunk is handed out.
   Monitor* LookupMonitor(MonitorId mon_id) {
     size_t offset = MonitorIdToOffset(mon_id);
     size_t index = offset / kChunkSize;
@@ -180,6 +195,12 @@ class MonitorPool {
     return static_cast<MonitorId>(offset >> 3);
   }
 
+  // Index of the chunk containing the monitor with the given id. The chunk is stored in
+  // monitor_chunks_[index / kMaxListSize][index % kMaxListSize].
+  static constexpr size_t MonitorIdToChunkIndex(MonitorId id) {
+    return MonitorIdToOffset(id) / kChunkSize;
+  }
+
   static constexpr size_t ChunkListCapacity(size_t index) {
     return kInitialChunkStorage << index;
   }
@@ -242,6 +263,10 @@ class MonitorPool {
   // Start of free list of monitors.
   // Note: these point to the right memory regions, but do *not* denote initialized objects.
   Monitor* first_free_ GUARDED_BY(Locks::allocated_monitor_ids_lock_);
+
+  // Indexes (see MonitorIdToChunkIndex()) of chunks released by ReleaseEmptyChunksInPool(). Their
+  // entries in monitor_chunks_ are null and are reused before allocating new entries.
+  std::vector<size_t> released_chunks_ GUARDED_BY(Locks::allocated_monitor_ids_lock_);
 #endif
 };
 
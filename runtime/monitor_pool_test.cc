@@ -124,4 +124,45 @@ TEST_F(MonitorPoolTest, MonitorPoolTest) {
   }
 }
 
+TEST_F(MonitorPoolTest, ReleaseEmptyChunks) {
+  // Enough monitors to fill several chunks.
+  const size_t kNumMonitors = 200;
+
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+
+  std::vector<Monitor*> monitors;
+  for (size_t i = 0; i < kNumMonitors; ++i) {
+    monitors.push_back(MonitorPool::CreateMonitor(self, self, nullptr, static_cast<int32_t>(i)));
+  }
+  // Keep the first monitor, so that at least one chunk is not empty.
+  Monitor* kept = monitors[0];
+  for (size_t i = 1; i < kNumMonitors; ++i) {
+    MonitorPool::ReleaseMonitor(self, monitors[i]);
+  }
+  monitors.clear();
+
+  size_t released = MonitorPool::ReleaseEmptyChunks(self);
+  if (sizeof(void*) == 8u) {
+    EXPECT_NE(released, 0u);
+  } else {
+    // Without a pool, monitors are freed individually.
+    EXPECT_EQ(released, 0u);
+  }
+  VerifyMonitor(kept, self);
+
+  // Allocate again, reusing the entries of the released chunks.
+  for (size_t i = 0; i < kNumMonitors; ++i) {
+    Monitor* mon = MonitorPool::CreateMonitor(self, self, nullptr, static_cast<int32_t>(i));
+    monitors.push_back(mon);
+    VerifyMonitor(mon, self);
+  }
+  VerifyMonitor(kept, self);
+
+  for (Monitor* mon : monitors) {
+    MonitorPool::ReleaseMonitor(self, mon);
+  }
+  MonitorPool::ReleaseMonitor(self, kept);
+}
+
 }  // namespace art
@@ -227,6 +227,20 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .IntoKey(M::DumpRegionInfoAfterGC)
       .Define("-XX:DumpJITInfoOnShutdown")
           .IntoKey(M::DumpJITInfoOnShutdown)
+      .Define("-XX:JITCompileEventLog")
+          .IntoKey(M::JITCompileEventLog)
+      .Define("-XX:JITCompileEventTraceFile:_")
+          .WithType<std::string>()
+          .IntoKey(M::JITCompileEventTraceFile)
+      .Define("-XX:JITAdaptiveThresholds:_")
+          .WithHelp("Adapt JIT hotness thresholds and tiering to the system load.")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::JITAdaptiveThresholds)
+      .Define("-XX:JITAdaptiveMaxWorkers=_")
+          .WithHelp("Maximum number of JIT threads used when the system is idle.")
+          .WithType<unsigned int>()
+          .IntoKey(M::JITAdaptiveMaxWorkers)
       .Define("-XX:IgnoreMaxFootprint")
           .IntoKey(M::IgnoreMaxFootprint)
       .Define("-XX:AlwaysLogExplicitGcs:_")
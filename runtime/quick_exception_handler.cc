@@ -313,6 +313,7 @@ class DeoptimizeStackVisitor final : public StackVisitor {
         single_frame_done_(false),
         single_frame_deopt_method_(nullptr),
         single_frame_deopt_quick_method_header_(nullptr),
+        single_frame_deopt_dex_pc_(dex::kDexNoIndex),
         callee_method_(nullptr) {
   }
 
@@ -324,6 +325,10 @@ class DeoptimizeStackVisitor final : public StackVisitor {
     return single_frame_deopt_quick_method_header_;
   }
 
+  uint32_t GetSingleFrameDeoptDexPc() const {
+    return single_frame_deopt_dex_pc_;
+  }
+
   void FinishStackWalk() REQUIRES_SHARED(Locks::mutator_lock_) {
     // This is the upcall, or the next full frame in single-frame deopt, or the
     // code isn't deoptimizeable. We remember the frame and last pc so that we
@@ -415,6 +420,7 @@ class DeoptimizeStackVisitor final : public StackVisitor {
         single_frame_done_ = true;
         single_frame_deopt_method_ = method;
         single_frame_deopt_quick_method_header_ = GetCurrentOatQuickMethodHeader();
+        single_frame_deopt_dex_pc_ = GetDexPc();
       }
       callee_method_ = method;
       return true;
@@ -548,6 +554,7 @@ class DeoptimizeStackVisitor final : public StackVisitor {
   bool single_frame_done_;
   ArtMethod* single_frame_deopt_method_;
   const OatQuickMethodHeader* single_frame_deopt_quick_method_header_;
+  uint32_t single_frame_deopt_dex_pc_;
   ArtMethod* callee_method_;
 
   DISALLOW_COPY_AND_ASSIGN(DeoptimizeStackVisitor);
@@ -603,7 +610,9 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
   // can be reused when debugging support (like breakpoints) are no longer
   // needed fot this method.
   if (Runtime::Current()->UseJitCompilation() && (kind != DeoptimizationKind::kDebugging)) {
-    Runtime::Current()->GetJit()->GetCodeCache()->InvalidateCompiledCodeFor(
+    jit::JitCodeCache* code_cache = Runtime::Current()->GetJit()->GetCodeCache();
+    code_cache->AddDeoptimizationFeedback(deopt_method, kind, visitor.GetSingleFrameDeoptDexPc());
+    code_cache->InvalidateCompiledCodeFor(
         deopt_method, visitor.GetSingleFrameDeoptQuickMethodHeader());
   } else {
     Runtime::Current()->GetInstrumentation()->InitializeMethodsCode(
@@ -4506,6 +4506,8 @@ static void SweepCacheEntry(IsMarkedVisitor* visitor,
 }
 
 void Thread::SweepInterpreterCache(IsMarkedVisitor* visitor) {
+  // Only the direct-mapped part of the cache can hold references, entries evicted
+  // from it to the secondary cache are field and method entries.
   bool read_from_space_class = Runtime::Current()->GetHeap()->IsPerformingUffdCompaction();
   for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetArray()) {
     SweepCacheEntry(visitor,
@@ -46,6 +46,7 @@
 #include "native_stack_dump.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread.h"
+#include "thread_pool.h"
 #include "trace.h"
 #include "well_known_classes.h"
 
@@ -67,6 +68,10 @@ static constexpr useconds_t kThreadSuspendInitialSleepUs = 0;
 static constexpr useconds_t kThreadSuspendMaxYieldUs = 3000;
 static constexpr useconds_t kThreadSuspendMaxSleepUs = 5000;
 
+// Minimum number of suspended threads for which RunCheckpoint() hands the checkpoint
+// function to a thread pool, below this waking up the workers costs more than it saves.
+static constexpr size_t kMinSuspendedThreadsForParallelCheckpoint = 4;
+
 // Whether we should try to dump the native stack of unattached threads. See commit ed8b723 for
 // some history.
 static constexpr bool kDumpUnattachedThreadNativeStackForSigQuit = true;
@@ -308,7 +313,24 @@ static void ThreadSuspendSleep(useconds_t delay_us) {
   }
 }
 
-size_t ThreadList::RunCheckpoint(Closure* checkpoint_function, Closure* callback) {
+// Run the checkpoint function on behalf of a suspended thread and remove the suspend request
+// that kept it suspended.
+static void RunCheckpointForSuspendedThread(Thread* self,
+                                            Thread* thread,
+                                            Closure* checkpoint_function) {
+  // We know for sure that the thread is suspended at this point.
+  DCHECK(thread->IsSuspended());
+  checkpoint_function->Run(thread);
+  {
+    MutexLock mu2(self, *Locks::thread_suspend_count_lock_);
+    bool updated = thread->ModifySuspendCount(self, -1, nullptr, SuspendReason::kInternal);
+    DCHECK(updated);
+  }
+}
+
+size_t ThreadList::RunCheckpoint(Closure* checkpoint_function,
+                                 Closure* callback,
+                                 ThreadPool* thread_pool) {
   Thread* self = Thread::Current();
   Locks::mutator_lock_->AssertNotExclusiveHeld(self);
   Locks::thread_list_lock_->AssertNotHeld(self);
@@ -370,18 +392,29 @@ size_t ThreadList::RunCheckpoint(Closure* checkpoint_function, Closure* callback
     }
   }
 
-  // Run the checkpoint on ourself while we wait for threads to suspend.
-  checkpoint_function->Run(self);
+  if (thread_pool != nullptr &&
+      thread_pool->GetThreadCount() != 0u &&
+      suspended_count_modified_threads.size() >= kMinSuspendedThreadsForParallelCheckpoint) {
+    // Let the thread pool run the checkpoint on the suspended threads, for example to scan
+    // their stacks in parallel, and help it after running the checkpoint on ourself. The
+    // workers are attached threads that do not become Runnable, so they may be among the
+    // suspended threads themselves.
+    for (Thread* thread : suspended_count_modified_threads) {
+      thread_pool->AddTask(self, new FunctionTask([thread, checkpoint_function](Thread* worker) {
+        RunCheckpointForSuspendedThread(worker, thread, checkpoint_function);
+      }));
+    }
+    thread_pool->StartWorkers(self);
+    checkpoint_function->Run(self);
+    thread_pool->Wait(self, /* do_work= */ true, /* may_hold_locks= */ true);
+    thread_pool->StopWorkers(self);
+  } else {
+    // Run the checkpoint on ourself while we wait for threads to suspend.
+    checkpoint_function->Run(self);
 
-  // Run the checkpoint on the suspended threads.
-  for (const auto& thread : suspended_count_modified_threads) {
-    // We know for sure that the thread is suspended at this point.
-    DCHECK(thread->IsSuspended());
-    checkpoint_function->Run(thread);
-    {
-      MutexLock mu2(self, *Locks::thread_suspend_count_lock_);
-      bool updated = thread->ModifySuspendCount(self, -1, nullptr, SuspendReason::kInternal);
-      DCHECK(updated);
+    // Run the checkpoint on the suspended threads.
+    for (const auto& thread : suspended_count_modified_threads) {
+      RunCheckpointForSuspendedThread(self, thread, checkpoint_function);
     }
   }
 
@@ -530,7 +563,9 @@ size_t ThreadList::FlipThreadRoots(Closure* thread_flip_visitor,
 
   // Run the flip callback for the collector.
   Locks::mutator_lock_->ExclusiveLock(self);
-  suspend_all_historam_.AdjustAndAddValue(NanoTime() - suspend_start_time);
+  const uint64_t suspend_time = NanoTime() - suspend_start_time;
+  suspend_all_historam_.AdjustAndAddValue(suspend_time);
+  Runtime::Current()->GetMetrics()->TimeToSafepoint()->Add(NsToUs(suspend_time));
   flip_callback->Run(self);
   // Releasing mutator-lock *before* setting up flip function in the threads
   // leaves a gap for another thread trying to suspend all threads. That thread
@@ -647,6 +682,7 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
     const uint64_t end_time = NanoTime();
     const uint64_t suspend_time = end_time - start_time;
     suspend_all_historam_.AdjustAndAddValue(suspend_time);
+    Runtime::Current()->GetMetrics()->TimeToSafepoint()->Add(NsToUs(suspend_time));
     if (suspend_time > kLongThreadSuspendThreshold) {
       LOG(WARNING) << "Suspending all threads took: " << PrettyDuration(suspend_time);
     }
@@ -665,6 +701,30 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
   }
 }
 
+void ThreadList::ReportSlowSuspendAll(Thread* self,
+                                      Thread* ignore1,
+                                      Thread* ignore2,
+                                      uint64_t wait_time) {
+  // The threads we are waiting for need the thread_suspend_count_lock_ to pass the suspend
+  // barrier, so only collect their tids under the thread_list_lock_ and format the report
+  // after releasing it.
+  std::vector<pid_t> slow_tids;
+  {
+    MutexLock mu(self, *Locks::thread_list_lock_);
+    for (const auto& thread : list_) {
+      if (thread != ignore1 && thread != ignore2 && !thread->IsSuspended()) {
+        slow_tids.push_back(thread->GetTid());
+      }
+    }
+  }
+  std::ostringstream oss;
+  for (pid_t tid : slow_tids) {
+    oss << " " << tid;
+  }
+  VLOG(threads) << "Slow suspension of all threads, waited for " << PrettyDuration(wait_time)
+                << ", threads not suspended (tid):" << oss.str();
+}
+
 // Ensures all threads running Java suspend and that those not running Java don't start.
 void ThreadList::SuspendAllInternal(Thread* self,
                                     Thread* ignore1,
@@ -700,6 +760,10 @@ void ThreadList::SuspendAllInternal(Thread* self,
     // Update global suspend all state for attaching threads.
     ++suspend_all_count_;
     pending_threads.store(list_.size() - num_ignored, std::memory_order_relaxed);
+    // Threads that are already suspended do not need to pass the barrier. Remove them from
+    // the counter in one update after the loop rather than contending with the runnable
+    // threads that decrement the same counter as they reach a suspend point.
+    int32_t num_suspended = 0;
     // Increment everybody's suspend count (except those that should be ignored).
     for (const auto& thread : list_) {
       if (thread == ignore1 || thread == ignore2) {
@@ -715,16 +779,22 @@ void ThreadList::SuspendAllInternal(Thread* self,
       if (thread->IsSuspended()) {
         // Only clear the counter for the current thread.
         thread->ClearSuspendBarrier(&pending_threads);
-        pending_threads.fetch_sub(1, std::memory_order_seq_cst);
+        ++num_suspended;
       }
     }
+    if (num_suspended != 0) {
+      pending_threads.fetch_sub(num_suspended, std::memory_order_seq_cst);
+    }
   }
 
   // Wait for the barrier to be passed by all runnable threads. This wait
-  // is done with a timeout so that we can detect problems.
+  // is done with a timeout so that we can detect problems. The first wait is
+  // short so that -verbose:threads can name the threads that are slow to reach
+  // a suspend point.
 #if ART_USE_FUTEXES
   timespec wait_timeout;
-  InitTimeSpec(false, CLOCK_MONOTONIC, NsToMs(thread_suspend_timeout_ns_), 0, &wait_timeout);
+  bool reported_slow_threads = false;
+  InitTimeSpec(false, CLOCK_MONOTONIC, NsToMs(kLongThreadSuspendThreshold), 0, &wait_timeout);
 #endif
   const uint64_t start_time = NanoTime();
   while (true) {
@@ -739,6 +809,15 @@ void ThreadList::SuspendAllInternal(Thread* self,
         }
         if (errno == ETIMEDOUT) {
           const uint64_t wait_time = NanoTime() - start_time;
+          if (!reported_slow_threads) {
+            reported_slow_threads = true;
+            if (VLOG_IS_ON(threads)) {
+              ReportSlowSuspendAll(self, ignore1, ignore2, wait_time);
+            }
+            InitTimeSpec(
+                false, CLOCK_MONOTONIC, NsToMs(thread_suspend_timeout_ns_), 0, &wait_timeout);
+            continue;
+          }
           MutexLock mu(self, *Locks::thread_list_lock_);
           MutexLock mu2(self, *Locks::thread_suspend_count_lock_);
           std::ostringstream oss;
@@ -40,6 +40,7 @@ class Closure;
 class IsMarkedVisitor;
 class RootVisitor;
 class Thread;
+class ThreadPool;
 class TimingLogger;
 enum VisitRootFlags : uint8_t;
 
@@ -114,8 +115,12 @@ class ThreadList {
   // return value includes already suspended threads for b/24191051. Runs or requests the
   // callback, if non-null, inside the thread_list_lock critical section after determining the
   // runnable/suspended states of the threads. Does not wait for completion of the callbacks in
-  // running threads.
-  size_t RunCheckpoint(Closure* checkpoint_function, Closure* callback = nullptr)
+  // running threads. If `thread_pool` is non-null, the checkpoint function for suspended threads
+  // may be run by its workers in parallel; the pool must not be in use and the checkpoint
+  // function must not transition the executing thread to Runnable.
+  size_t RunCheckpoint(Closure* checkpoint_function,
+                       Closure* callback = nullptr,
+                       ThreadPool* thread_pool = nullptr)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
   // Run an empty checkpoint on threads. Wait until threads pass the next suspend point or are
@@ -202,6 +207,10 @@ class ThreadList {
                           SuspendReason reason = SuspendReason::kInternal)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // Log the tids of the threads that have not suspended yet after waiting `wait_time` ns.
+  void ReportSlowSuspendAll(Thread* self, Thread* ignore1, Thread* ignore2, uint64_t wait_time)
+      REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
+
   void AssertThreadsAreSuspended(Thread* self, Thread* ignore1, Thread* ignore2 = nullptr)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
@@ -72,6 +72,7 @@ public class Main {
     test_StrictMath_round_F();
     test_String_charAt();
     test_String_compareTo();
+    test_String_compareToAllPositions();
     test_String_indexOf();
     test_String_isEmpty();
     test_String_length();
@@ -312,6 +313,38 @@ public class Main {
     testStringIndexOfChars(searchData);
 
     testSurrogateIndexOf();
+    testIndexOfAllPositions();
+  }
+
+  // Exercise the chunked search with every match position and start index around the chunk
+  // boundaries, in both Latin-1 and UTF-16 strings.
+  private static void testIndexOfAllPositions() {
+    for (int length = 0; length <= 40; ++length) {
+      char[] latin1 = new char[length];
+      char[] utf16 = new char[length];
+      for (int i = 0; i < length; ++i) {
+        latin1[i] = (char) ('a' + (i % 3));
+        utf16[i] = (char) (0x100 + (i % 3));
+      }
+      for (int pos = 0; pos < length; ++pos) {
+        latin1[pos] = 'x';
+        utf16[pos] = '\u1234';
+        String l = new String(latin1);
+        String u = new String(utf16);
+        Assert.assertEquals(l.indexOf('x'), pos);
+        Assert.assertEquals(u.indexOf('\u1234'), pos);
+        for (int from = 0; from <= length; ++from) {
+          Assert.assertEquals(l.indexOf('x', from), from <= pos ? pos : -1);
+          Assert.assertEquals(u.indexOf('\u1234', from), from <= pos ? pos : -1);
+        }
+        // A char that only matches in the low byte must not be found.
+        Assert.assertEquals(u.indexOf('\u0034'), -1);
+        latin1[pos] = (char) ('a' + (pos % 3));
+        utf16[pos] = (char) (0x100 + (pos % 3));
+      }
+      Assert.assertEquals(new String(latin1).indexOf('x'), -1);
+      Assert.assertEquals(new String(utf16).indexOf('\u1234'), -1);
+    }
   }
 
   private static void testStringIndexOfChars(int[][] searchData) {
@@ -465,6 +498,43 @@ public class Main {
     Assert.assertEquals("this is a path", test.replace("/", " "));
   }
 
+  // Exercise the chunked comparison with every mismatch position and length around the
+  // chunk boundaries, in both Latin-1 and UTF-16 strings.
+  public static void test_String_compareToAllPositions() {
+    for (int length = 0; length <= 40; ++length) {
+      char[] latin1 = new char[length];
+      char[] utf16 = new char[length];
+      for (int i = 0; i < length; ++i) {
+        latin1[i] = (char) ('a' + (i % 3));
+        utf16[i] = (char) (0x100 + (i % 3));
+      }
+      String l = new String(latin1);
+      String u = new String(utf16);
+      Assert.assertEquals(l.compareTo(new String(latin1)), 0);
+      Assert.assertEquals(u.compareTo(new String(utf16)), 0);
+      Assert.assertEquals(l.compareTo(l + "a"), -1);
+      Assert.assertEquals((u + "\u0100").compareTo(u), 1);
+      for (int pos = 0; pos < length; ++pos) {
+        char savedLatin1 = latin1[pos];
+        char savedUtf16 = utf16[pos];
+        latin1[pos] = 'x';
+        // Only differs in the high byte, to check that chars are compared as a whole.
+        utf16[pos] = (char) (savedUtf16 + 0x100);
+        String l2 = new String(latin1);
+        String u2 = new String(utf16);
+        Assert.assertEquals(l.compareTo(l2), savedLatin1 - 'x');
+        Assert.assertEquals(l2.compareTo(l), 'x' - savedLatin1);
+        Assert.assertEquals(u.compareTo(u2), -0x100);
+        Assert.assertEquals(u2.compareTo(u), 0x100);
+        // A mismatch beyond the end of the shorter string does not count.
+        Assert.assertEquals(l.substring(0, pos).compareTo(l2), -(length - pos));
+        Assert.assertEquals(u2.compareTo(u.substring(0, pos)), length - pos);
+        latin1[pos] = savedLatin1;
+        utf16[pos] = savedUtf16;
+      }
+    }
+  }
+
   public static void test_Math_abs_I() {
     Math.abs(-1);
     Assert.assertEquals(Math.abs(0), 0);
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for vectorization of loops with control flow that is if-converted
+ * into selects or min/max operations.
+ */
+public class Main {
+
+  /// CHECK-START: void Main.clamp(int[], int, int) loop_optimization (before)
+  /// CHECK-DAG: Phi       loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArrayGet  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: Max       loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: Min       loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArraySet  loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-ARM64: void Main.clamp(int[], int, int) loop_optimization (after)
+  /// CHECK-IF:     not hasIsaFeature("sve")
+  //
+  ///     CHECK-DAG: VecLoad   loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecMax    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecMin    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecStore  loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86_64: void Main.clamp(int[], int, int) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: VecLoad   loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecMax    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecMin    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecStore  loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86: void Main.clamp(int[], int, int) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: VecLoad   loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecMax    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecMin    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: VecStore  loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void clamp(int[] x, int lo, int hi) {
+    for (int i = 0; i < x.length; i++) {
+      x[i] = Math.min(Math.max(x[i], lo), hi);
+    }
+  }
+
+  /// CHECK-START: void Main.selectGreater(int[], int[], int[]) loop_optimization (before)
+  /// CHECK-DAG: Phi         loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: GreaterThan loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: Select      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArraySet    loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-ARM64: void Main.selectGreater(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     not hasIsaFeature("sve")
+  //
+  ///     CHECK-DAG: <<Ld1:d\d+>>  VecLoad                            loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>  VecLoad                            loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Cnd:d\d+>>  VecCondition [<<Ld1>>,<<Ld2>>]     loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:               VecSelect [<<Cnd>>,{{d\d+}},{{d\d+}}] loop:<<Loop>>   outer_loop:none
+  ///     CHECK-DAG:               VecStore                           loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  // SVE has no code generation for vector conditions and selects.
+  ///     CHECK-NOT: VecCondition
+  ///     CHECK-NOT: VecSelect
+  //
+  /// CHECK-FI:
+  //
+  // Neither has ARM.
+  /// CHECK-START-ARM: void Main.selectGreater(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-NOT: VecCondition
+  /// CHECK-NOT: VecSelect
+  //
+  /// CHECK-START-X86_64: void Main.selectGreater(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: <<Ld1:d\d+>>  VecLoad                            loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>  VecLoad                            loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Cnd:d\d+>>  VecCondition [<<Ld1>>,<<Ld2>>]     loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:               VecSelect [<<Cnd>>,{{d\d+}},{{d\d+}}] loop:<<Loop>>   outer_loop:none
+  ///     CHECK-DAG:               VecStore                           loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86: void Main.selectGreater(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: <<Ld1:d\d+>>  VecLoad                            loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>  VecLoad                            loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Cnd:d\d+>>  VecCondition [<<Ld1>>,<<Ld2>>]     loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:               VecSelect [<<Cnd>>,{{d\d+}},{{d\d+}}] loop:<<Loop>>   outer_loop:none
+  ///     CHECK-DAG:               VecStore                           loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void selectGreater(int[] a, int[] b, int[] c) {
+    for (int i = 0; i < c.length; i++) {
+      c[i] = (a[i] > b[i]) ? a[i] - b[i] : b[i];
+    }
+  }
+
+  /// CHECK-START-ARM64: void Main.selectLessEqual(int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     not hasIsaFeature("sve")
+  //
+  ///     CHECK-DAG: VecCondition loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecSelect    loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-NOT: VecCondition
+  ///     CHECK-NOT: VecSelect
+  //
+  /// CHECK-FI:
+  //
+  /// CHECK-START-ARM: void Main.selectLessEqual(int[], int[]) loop_optimization (after)
+  /// CHECK-NOT: VecCondition
+  /// CHECK-NOT: VecSelect
+  //
+  /// CHECK-START-X86_64: void Main.selectLessEqual(int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: VecCondition loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecSelect    loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  //
+  /// CHECK-START-X86: void Main.selectLessEqual(int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("sse4.1")
+  //
+  ///     CHECK-DAG: VecCondition loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: VecSelect    loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void selectLessEqual(int[] a, int[] c) {
+    for (int i = 0; i < c.length; i++) {
+      c[i] = (a[i] <= 7) ? 1 : -1;
+    }
+  }
+
+  /// CHECK-START: void Main.selectFloat(float[], float[]) loop_optimization (after)
+  /// CHECK-NOT: VecSelect
+  private static void selectFloat(float[] a, float[] c) {
+    for (int i = 0; i < c.length; i++) {
+      c[i] = (a[i] > 0.0f) ? a[i] : 0.0f;
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] x = new int[100];
+    int[] y = new int[100];
+    int[] z = new int[100];
+    for (int i = 0; i < 100; i++) {
+      x[i] = (i * 37) - 1800;
+      y[i] = 50 - i;
+    }
+
+    int[] c = x.clone();
+    clamp(c, -1000, 1000);
+    for (int i = 0; i < 100; i++) {
+      expectEquals(Math.min(Math.max(x[i], -1000), 1000), c[i]);
+    }
+
+    selectGreater(x, y, z);
+    for (int i = 0; i < 100; i++) {
+      expectEquals((x[i] > y[i]) ? x[i] - y[i] : y[i], z[i]);
+    }
+
+    selectLessEqual(y, z);
+    for (int i = 0; i < 100; i++) {
+      expectEquals((y[i] <= 7) ? 1 : -1, z[i]);
+    }
+
+    float[] f = new float[100];
+    float[] g = new float[100];
+    for (int i = 0; i < 100; i++) {
+      f[i] = i - 50.5f;
+    }
+    selectFloat(f, g);
+    for (int i = 0; i < 100; i++) {
+      expectEquals((f[i] > 0.0f) ? f[i] : 0.0f, g[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (Float.compare(expected, result) != 0) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
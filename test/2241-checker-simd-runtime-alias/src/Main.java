@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for vectorization of loops over array parameters that may be aliased,
+ * which needs runtime tests on the array references.
+ */
+public class Main {
+
+  static final int N = 100;
+
+  /// CHECK-START-ARM64: void Main.shiftedAdd(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-DAG: NotEqual  loop:none
+  /// CHECK-DAG: NotEqual  loop:none
+  /// CHECK-DAG: VecLoad   loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecAdd    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecStore  loop:<<Loop>>      outer_loop:none
+  private static void shiftedAdd(int[] c, int[] a, int[] b) {
+    for (int i = 0; i < N; i++) {
+      c[i + 1] = a[i] + b[i + 2];
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N + 2];
+    int[] b = new int[N + 2];
+    for (int i = 0; i < N + 2; i++) {
+      a[i] = i;
+      b[i] = 1000 - i;
+    }
+
+    // Disjoint arrays.
+    int[] c = new int[N + 2];
+    shiftedAdd(c, a, b);
+    for (int i = 0; i < N; i++) {
+      expectEquals(a[i] + b[i + 2], c[i + 1]);
+    }
+
+    // Aliased arrays, with a loop-carried dependence the vector loop would violate.
+    int[] x = a.clone();
+    int[] expected = a.clone();
+    for (int i = 0; i < N; i++) {
+      expected[i + 1] = expected[i] + b[i + 2];
+    }
+    shiftedAdd(x, x, b);
+    for (int i = 0; i < N + 2; i++) {
+      expectEquals(expected[i], x[i]);
+    }
+
+    x = b.clone();
+    expected = b.clone();
+    for (int i = 0; i < N; i++) {
+      expected[i + 1] = a[i] + expected[i + 2];
+    }
+    shiftedAdd(x, a, x);
+    for (int i = 0; i < N + 2; i++) {
+      expectEquals(expected[i], x[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
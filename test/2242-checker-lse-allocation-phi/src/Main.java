@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for load-store elimination of temporaries that are merged by Phis,
+ * either at the end of an `if` or around a loop.
+ */
+public class Main {
+
+  static class Pair {
+    int first;
+    int second;
+
+    Pair(int first, int second) {
+      this.first = first;
+      this.second = second;
+    }
+  }
+
+  static Pair escaped;
+
+  /// CHECK-START: int Main.merged(boolean, int) load_store_elimination (before)
+  /// CHECK: NewInstance
+  /// CHECK: NewInstance
+
+  /// CHECK-START: int Main.merged(boolean, int) load_store_elimination (after)
+  /// CHECK-NOT: NewInstance
+  /// CHECK-NOT: InstanceFieldGet
+  private static int merged(boolean flag, int value) {
+    Pair p;
+    if (flag) {
+      p = new Pair(value, 1);
+    } else {
+      p = new Pair(2, value);
+    }
+    return p.first * 10 + p.second;
+  }
+
+  /// CHECK-START: int Main.loopCarried(int) load_store_elimination (before)
+  /// CHECK: NewInstance loop:none
+  /// CHECK: NewInstance loop:{{B\d+}}
+
+  /// CHECK-START: int Main.loopCarried(int) load_store_elimination (after)
+  /// CHECK-NOT: NewInstance
+  /// CHECK-NOT: InstanceFieldGet
+  private static int loopCarried(int n) {
+    Pair p = new Pair(0, 1);
+    for (int i = 0; i < n; i++) {
+      p = new Pair(p.first + i, p.second * 2);
+    }
+    return p.first + p.second;
+  }
+
+  /// CHECK-START: int Main.mergedEscaping(boolean, int) load_store_elimination (after)
+  /// CHECK: NewInstance
+  /// CHECK: NewInstance
+  private static int mergedEscaping(boolean flag, int value) {
+    Pair p;
+    if (flag) {
+      p = new Pair(value, 1);
+      escaped = p;
+    } else {
+      p = new Pair(2, value);
+    }
+    return p.first * 10 + p.second;
+  }
+
+  public static void main(String[] args) {
+    expectEquals(31, merged(true, 3));
+    expectEquals(23, merged(false, 3));
+
+    expectEquals(1, loopCarried(0));
+    expectEquals(2, loopCarried(1));
+    expectEquals(45 + 1024, loopCarried(10));
+
+    expectEquals(51, mergedEscaping(true, 5));
+    expectEquals(5, escaped.first);
+    expectEquals(25, mergedEscaping(false, 5));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
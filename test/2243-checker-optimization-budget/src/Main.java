@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests that a method over the optimization budget is still compiled, and that only the
+ * inliner, load-store elimination and loop optimization are skipped for it.
+ */
+public class Main {
+
+  static class Point {
+    int x;
+  }
+
+  static int add(int a, int b) {
+    return a + b;
+  }
+
+  /// CHECK-START: int Main.overBudget(Main$Point, int) GVN (before)
+  /// CHECK:         Mul
+  /// CHECK:         Mul
+
+  /// CHECK-START: int Main.overBudget(Main$Point, int) GVN (after)
+  /// CHECK:         Mul
+  /// CHECK-NOT:     Mul
+
+  /// CHECK-START: int Main.overBudget(Main$Point, int) instruction_simplifier$before_codegen (after)
+  /// CHECK-DAG:     InstanceFieldSet
+  /// CHECK-DAG:     InstanceFieldGet
+  /// CHECK-DAG:     InvokeStaticOrDirect method_name:Main.add
+  private static int overBudget(Point p, int x) {
+    // Load-store elimination would replace the load with the stored value.
+    p.x = x;
+    int y = p.x;
+    // GVN still removes the second multiplication.
+    int a = x * x;
+    int b = x * x;
+    // The inliner would inline the call.
+    return add(a, b) + y;
+  }
+
+  public static void main(String[] args) {
+    Point p = new Point();
+    expectEquals(21, overBudget(p, 3));
+    expectEquals(3, p.x);
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+interface SingleItf {
+  int compute(int x);
+}
+
+// The only implementation of SingleItf.
+class SingleImpl implements SingleItf {
+  // Too large to be inlined.
+  public int compute(int x) {
+    x = x * 31 + 7;
+    x ^= x >>> 3;
+    x = x * 17 + 5;
+    x ^= x >>> 7;
+    x = x * 13 + 3;
+    x ^= x >>> 11;
+    x = x * 29 + 1;
+    x ^= x >>> 13;
+    x = x * 11 + 9;
+    x ^= x >>> 5;
+    x = x * 23 + 2;
+    x ^= x >>> 17;
+    return x;
+  }
+}
+
+interface MultiItf {
+  int compute(int x);
+}
+
+class MultiImplA implements MultiItf {
+  // Too large to be inlined.
+  public int compute(int x) {
+    x = x * 31 + 7;
+    x ^= x >>> 3;
+    x = x * 17 + 5;
+    x ^= x >>> 7;
+    x = x * 13 + 3;
+    x ^= x >>> 11;
+    x = x * 29 + 1;
+    x ^= x >>> 13;
+    x = x * 11 + 9;
+    x ^= x >>> 5;
+    x = x * 23 + 2;
+    x ^= x >>> 17;
+    return x;
+  }
+}
+
+class MultiImplB implements MultiItf {
+  public int compute(int x) {
+    return x + 1;
+  }
+}
+
+public class Main {
+
+  // SingleImpl.compute is the single implementation of SingleItf.compute and is
+  // too large to be inlined, so the interface call becomes a direct call guarded
+  // by CHA.
+
+  /// CHECK-START: int Main.$noinline$callSingleImpl(SingleItf, int) inliner (before)
+  /// CHECK:       InvokeInterface method_name:SingleItf.compute
+
+  /// CHECK-START: int Main.$noinline$callSingleImpl(SingleItf, int) inliner (after)
+  /// CHECK:       <<Flag:i\d+>> ShouldDeoptimizeFlag
+  /// CHECK:       <<Cond:z\d+>> NotEqual [<<Flag>>,{{i\d+}}]
+  /// CHECK:                     Deoptimize [<<Cond>>]
+  /// CHECK:                     InvokeStaticOrDirect method_name:SingleImpl.compute
+
+  /// CHECK-START: int Main.$noinline$callSingleImpl(SingleItf, int) inliner (after)
+  /// CHECK-NOT:   InvokeInterface
+
+  public static int $noinline$callSingleImpl(SingleItf itf, int x) {
+    return itf.compute(x);
+  }
+
+  // MultiItf.compute has two loaded implementations, so the call stays an
+  // interface call.
+
+  /// CHECK-START: int Main.$noinline$callMultipleImpls(MultiItf, int) inliner (after)
+  /// CHECK:       InvokeInterface method_name:MultiItf.compute
+
+  /// CHECK-START: int Main.$noinline$callMultipleImpls(MultiItf, int) inliner (after)
+  /// CHECK-NOT:   ShouldDeoptimizeFlag
+  /// CHECK-NOT:   InvokeStaticOrDirect method_name:MultiImplA.compute
+
+  public static int $noinline$callMultipleImpls(MultiItf itf, int x) {
+    return itf.compute(x);
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+
+    // Link the implementations before compiling the callers.
+    SingleItf single = new SingleImpl();
+    MultiItf multiA = new MultiImplA();
+    MultiItf multiB = new MultiImplB();
+
+    ensureJitCompiled(Main.class, "$noinline$callSingleImpl");
+    ensureJitCompiled(Main.class, "$noinline$callMultipleImpls");
+
+    assertEquals(single.compute(42), $noinline$callSingleImpl(single, 42));
+    assertEquals(multiA.compute(42), $noinline$callMultipleImpls(multiA, 42));
+    assertEquals(multiB.compute(42), $noinline$callMultipleImpls(multiB, 42));
+  }
+
+  private static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  private static native void ensureJitCompiled(Class<?> itf, String method_name);
+}